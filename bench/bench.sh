@@ -0,0 +1,166 @@
+#!/usr/bin/env bash
+# **************************************************************************** #
+#                                                                              #
+#   bench.sh : banc de mesure de débit et de latence de Minitalk               #
+#                                                                              #
+#   Lance chaque serveur, lit son PID sur sa sortie, puis envoie une matrice   #
+#   de messages (tailles x contenus) avec le client correspondant. Chaque      #
+#   ligne CSV donne le débit (bits/s, messages/s) et les percentiles de        #
+#   latence p50/p99/p999 d'un message, du lancement du client à sa sortie     #
+#   (confirmation finale du serveur comprise).                                 #
+#                                                                              #
+#   Variables d'environnement :                                                #
+#     BENCH_MODES  configurations "binaire:options" séparées par des virgules  #
+#     BENCH_SIZES  tailles en octets                                           #
+#     BENCH_TYPES  contenus : random, text, zero                               #
+#     BENCH_RUNS   messages par mesure (3 au-delà de BENCH_LARGE octets)       #
+#     BENCH_OUT    fichier CSV à écrire en plus de la sortie standard          #
+#                                                                              #
+# **************************************************************************** #
+
+set -u
+
+MODES=${BENCH_MODES:-"client:,client:-r,client_bonus:,client_bonus:-r,client_bonus:-w 64,client_bonus:-m,client_bonus:-z,client_bonus:-H,client_bonus:-a 16,client_bonus:-j 4"}
+SIZES=${BENCH_SIZES:-"1 16 256 4096 65536 1048576"}
+TYPES=${BENCH_TYPES:-"random text zero"}
+RUNS=${BENCH_RUNS:-20}
+LARGE=${BENCH_LARGE:-65536}
+TIMEOUT=${BENCH_TIMEOUT:-120}
+# Un argument de la ligne de commande est limité à MAX_ARG_STRLEN (128 Kio)
+ARG_MAX_BYTES=131071
+
+ROOT=$(cd "$(dirname "$0")/.." && pwd)
+TMP=$(mktemp -d)
+SERVER_PID=0
+trap '[ $SERVER_PID -ne 0 ] && kill $SERVER_PID 2>/dev/null; rm -rf "$TMP"' EXIT
+
+# Horloge murale en nanosecondes : date n'expose pas d'horloge monotone,
+# un réglage de l'heure pendant une mesure en fausserait l'échantillon
+now_ns() { date +%s%N; }
+
+# Génère le contenu d'un message dans un fichier.
+# Les messages passent par argv : ni '\0' ni '\n' final ne peuvent y
+# figurer, et 0xF8-0xFF sont réservés aux octets de contrôle en tête de
+# message. "zero" est donc une suite constante du caractère '0'.
+gen_payload() {
+	local type=$1 size=$2 out=$3
+	case $type in
+		random) head -c $((size * 2 + 64)) /dev/urandom \
+			| tr -d '\000\n\370-\377' | head -c "$size" > "$out" ;;
+		text) yes "The quick brown fox jumps over the lazy dog." \
+			| tr '\n' ' ' | head -c "$size" > "$out" ;;
+		zero) head -c "$size" /dev/zero | tr '\000' '0' > "$out" ;;
+	esac
+}
+
+# Démarre le serveur associé au client et attend l'affichage de son PID
+start_server() {
+	local bin=$1 i=0
+	"$ROOT/$bin" > "$TMP/server.out" 2>&1 &
+	SERVER_PID=$!
+	while [ $i -lt 100 ]; do
+		if sed -n 's/^\([0-9][0-9]*\)$/\1/p; s/.*PID: \([0-9][0-9]*\).*/\1/p' \
+			"$TMP/server.out" | grep -qx "$SERVER_PID"; then
+			return 0
+		fi
+		sleep 0.05
+		i=$((i + 1))
+	done
+	echo "bench: $bin n'a pas affiché son PID" >&2
+	return 1
+}
+
+stop_server() {
+	kill $SERVER_PID 2>/dev/null
+	wait $SERVER_PID 2>/dev/null
+	SERVER_PID=0
+}
+
+# Percentile p (0 < p <= 1) d'une liste triée de latences en ns, en ms
+percentile() {
+	awk -v p="$2" '{ v[NR] = $1 } END {
+		i = int(p * NR); if (i < p * NR) i++; if (i < 1) i = 1;
+		printf "%.3f", v[i] / 1e6 }' "$1"
+}
+
+# Envoie le contenu généré par argv, ou par -f au-delà de ARG_MAX_BYTES
+send_payload() {
+	local client=$1 flags=$2 size=$3
+	if [ "$size" -gt $ARG_MAX_BYTES ]; then
+		timeout "$TIMEOUT" "$ROOT/$client" "$SERVER_PID" -f "$TMP/payload" \
+			> /dev/null 2>&1
+		return
+	fi
+	# shellcheck disable=SC2086
+	timeout "$TIMEOUT" "$ROOT/$client" "$SERVER_PID" \
+		"$(cat "$TMP/payload")" $flags > /dev/null 2>&1
+}
+
+# Mesure une configuration : client, options, contenu et taille.
+# Au-delà de la limite d'argv, le contenu passe par -f, qui ne se combine
+# pas avec les options de mode : seule la configuration sans option est
+# alors mesurée.
+bench_one() {
+	local client=$1 flags=$2 type=$3 size=$4 runs=$RUNS
+	local errors=0 total=0 start end r rates note=
+	if [ "$size" -gt $ARG_MAX_BYTES ]; then
+		if [ -n "$flags" ]; then
+			echo "$client,$flags,$type,$size,0,0,,,,,,skipped (argv limit; -f takes no mode flags)"
+			return
+		fi
+		note="via -f"
+	fi
+	[ "$size" -ge "$LARGE" ] && runs=3
+	gen_payload "$type" "$size" "$TMP/payload"
+	: > "$TMP/lat"
+	for ((r = 0; r < runs; r++)); do
+		start=$(now_ns)
+		if send_payload "$client" "$flags" "$size"; then
+			end=$(now_ns)
+			echo $((end - start)) >> "$TMP/lat"
+			total=$((total + end - start))
+		else
+			errors=$((errors + 1))
+		fi
+	done
+	sort -n "$TMP/lat" -o "$TMP/lat"
+	local ok=$((runs - errors))
+	if [ $ok -eq 0 ]; then
+		echo "$client,$flags,$type,$size,$runs,$errors,,,,,,all runs failed"
+		return
+	fi
+	rates=$(awk -v ok=$ok -v t=$total -v s="$size" 'BEGIN {
+		printf "%.0f,%.2f", ok * s * 8 / (t / 1e9), ok / (t / 1e9) }')
+	echo "$client,$flags,$type,$size,$runs,$errors,$rates,$(percentile \
+		"$TMP/lat" 0.5),$(percentile "$TMP/lat" 0.99),$(percentile \
+		"$TMP/lat" 0.999),$note"
+}
+
+main() {
+	local mode client flags server
+	echo "client,flags,content,size_bytes,runs,errors,bits_per_sec,msgs_per_sec,p50_ms,p99_ms,p999_ms,note"
+	IFS=',' read -r -a mode_list <<< "$MODES"
+	for mode in "${mode_list[@]}"; do
+		client=${mode%%:*}
+		flags=${mode#*:}
+		server=${client/client/server}
+		if [ ! -x "$ROOT/$client" ] || [ ! -x "$ROOT/$server" ]; then
+			echo "bench: $client/$server introuvable, lancez make all bonus" >&2
+			continue
+		fi
+		start_server "$server" || continue
+		for type in $TYPES; do
+			for size in $SIZES; do
+				echo "bench: $client $flags $type $size" >&2
+				bench_one "$client" "$flags" "$type" "$size"
+			done
+		done
+		stop_server
+	done
+}
+
+if [ -n "${BENCH_OUT:-}" ]; then
+	main | tee "$BENCH_OUT"
+else
+	main
+fi
@@ -0,0 +1,87 @@
+#!/usr/bin/env bash
+# **************************************************************************** #
+#                                                                              #
+#   reserved.sh : test de non-régression des octets de contrôle                #
+#                                                                              #
+#   0xF8-0xFF sont réservés aux octets de contrôle en tête de message. Un      #
+#   message en clair qui commence par l'un d'eux doit pourtant arriver         #
+#   intact : le client le fait précéder de CTL_ESC. Chaque octet réservé       #
+#   est envoyé en tête d'un message dans chaque mode du client bonus, puis     #
+#   la sortie du serveur est comparée au message envoyé.                       #
+#                                                                              #
+#   Variables d'environnement :                                                #
+#     RESERVED_MODES    options du client, séparées par des virgules           #
+#     RESERVED_TIMEOUT  délai maximal d'un envoi, en secondes                  #
+#                                                                              #
+# **************************************************************************** #
+
+set -u
+
+MODES=${RESERVED_MODES:-",-r,-w 8,-m,-z,-H,-l,-a 4,-j 2"}
+TIMEOUT=${RESERVED_TIMEOUT:-10}
+
+ROOT=$(cd "$(dirname "$0")/.." && pwd)
+TMP=$(mktemp -d)
+SERVER_PID=0
+trap '[ $SERVER_PID -ne 0 ] && kill $SERVER_PID 2>/dev/null; rm -rf "$TMP"' EXIT
+
+# Démarre server_bonus et attend l'affichage de son PID
+start_server() {
+	local i=0
+	"$ROOT/server_bonus" > "$TMP/server.out" 2>&1 &
+	SERVER_PID=$!
+	while [ $i -lt 100 ]; do
+		if grep -q "PID: $SERVER_PID" "$TMP/server.out"; then
+			return 0
+		fi
+		sleep 0.05
+		i=$((i + 1))
+	done
+	echo "reserved: server_bonus n'a pas affiché son PID" >&2
+	return 1
+}
+
+# Compte les lignes de la sortie du serveur égales au message, couleurs
+# ANSI retirées
+count_lines() {
+	LC_ALL=C sed 's/\x1b\[[0-9;]*m//g' "$TMP/server.out" \
+		| LC_ALL=C grep -cxF -- "$1"
+}
+
+main() {
+	local mode byte msg failed=0 total=0
+	if [ ! -x "$ROOT/client_bonus" ] || [ ! -x "$ROOT/server_bonus" ]; then
+		echo "reserved: client_bonus/server_bonus introuvable, lancez make bonus" >&2
+		return 1
+	fi
+	start_server || return 1
+	IFS=',' read -r -a mode_list <<< "$MODES"
+	for byte in f8 f9 fa fb fc fd fe ff; do
+		msg="$(printf "\\x$byte")reserved $byte"
+		for mode in "${mode_list[@]}"; do
+			total=$((total + 1))
+			# shellcheck disable=SC2086
+			if ! timeout "$TIMEOUT" "$ROOT/client_bonus" "$SERVER_PID" \
+				"$msg" $mode > /dev/null 2>&1; then
+				echo "FAIL 0x$byte [$mode] : client en échec" >&2
+				failed=$((failed + 1))
+			fi
+		done
+		sleep 0.2
+		if [ "$(count_lines "$msg")" -ne ${#mode_list[@]} ]; then
+			echo "FAIL 0x$byte : $(count_lines "$msg")/${#mode_list[@]}" \
+				"messages intacts" >&2
+			failed=$((failed + 1))
+		fi
+	done
+	kill $SERVER_PID 2>/dev/null
+	wait $SERVER_PID 2>/dev/null
+	SERVER_PID=0
+	if [ $failed -ne 0 ]; then
+		echo "reserved: $failed échec(s) sur $total envois" >&2
+		return 1
+	fi
+	echo "reserved: $total envois intacts"
+}
+
+main
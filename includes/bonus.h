@@ -6,7 +6,7 @@
 /*   By: fdi-tria <fdi-tria@student.42lausanne.c    +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/01/25 20:43:38 by fdi-tria          #+#    #+#             */
-/*   Updated: 2025/01/25 20:47:12 by fdi-tria         ###   ########.fr       */
+/*   Updated: 2026/10/16 16:19:02 by fdi-tria         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -17,6 +17,222 @@
 # include <unistd.h>
 # include <stdlib.h>
 # include <sys/types.h>
+# include <stdatomic.h>
+# include <sys/time.h>
+# include <aio.h>
+# include <stdint.h>
+# include "trace.h"
+
+/*
+ * Tampon de sortie : taille et délai maximal avant vidage, modifiables
+ * à la compilation (-DOUT_BUF_SIZE=... -DOUT_FLUSH_MS=...). Un délai nul
+ * désactive le vidage périodique.
+ */
+# ifndef OUT_BUF_SIZE
+#  define OUT_BUF_SIZE 4096
+# endif
+# ifndef OUT_FLUSH_MS
+#  define OUT_FLUSH_MS 50
+# endif
+
+/*
+ * Signaux temps réel du protocole, exprimés en décalage depuis SIGRTMIN
+ * (SIGRTMIN n'est pas une constante sous glibc).
+ */
+# define RT_WORD 0
+# define RT_SEQ 1
+# define RT_ACK 2
+# define RT_DOORBELL 3
+// Premier symbole de l'alphabet (-a) ; les suivants vont jusqu'à SIGRTMAX
+# define RT_SYM 4
+
+// Une unité numérotée (-w) porte [seq:16 | données:16] dans sival_int
+# define SEQ_UNIT_BYTES 2
+
+/*
+ * Contrôle de congestion de la fenêtre glissante (-w N) : AIMD sur le
+ * nombre d'unités en vol, N n'étant plus qu'un plafond. La fenêtre est
+ * réduite de moitié quand le RTT lissé dépasse de plus de CC_QUEUE_US le
+ * plus petit RTT lissé observé (attente dans la file du serveur), ou
+ * quand cette file refuse une unité ;
+ * elle retombe à 1 si aucun acquittement n'arrive avant le RTO.
+ */
+# define CC_QUEUE_US 5000
+# define CC_RTO_INIT_US 200000
+# define CC_RTO_MIN_US 1000
+# define CC_RTO_MAX_US 1000000
+# define SEQ_MAX_WINDOW 32767
+
+/*
+ * Reprise du mode bit par bit : SIGUSR1 et SIGUSR2 ne sont pas mis en
+ * file, deux clients qui émettent le même signal pendant que le
+ * gestionnaire du serveur s'exécute n'en délivrent qu'un. Chaque bit
+ * porte un numéro sur 16 bits ; sans acquittement avant le RTO (même
+ * estimateur que -w), il est renvoyé, au plus BIT_RETX_MAX fois. Les
+ * mots de -r suivent le même chemin : mis en file, ils peuvent encore
+ * déborder la file du serveur, et leur acquittement SIGUSR1 se perdre.
+ */
+# define BIT_RETX_MAX 30
+
+// Table des sessions du serveur : capacité fixe, puissance de 2
+# define SESSION_MAX 64
+/*
+ * Session abandonnée : aucun signal depuis SESSION_IDLE_US, soit
+ * BIT_RETX_MAX échéances de CC_RTO_MAX_US au bout desquelles un client
+ * vivant a déjà renoncé, ou client disparu. Elle n'est reprise que
+ * lorsque la table est pleine.
+ */
+# define SESSION_IDLE_US 30000000L
+// Tampon de sortie propre à chaque session, vidé par blocs
+# define SESSION_BUF 512
+/*
+ * File des signaux reçus par le serveur, puissance de 2. Chaque entrée
+ * attend son acquittement : elle borne la somme des fenêtres (-w) et
+ * des unités en vol de tous les clients.
+ */
+# define SIGQ_SIZE 65536
+
+/*
+ * Ordonnancement équitable du serveur (-R, -B, -Q) : seau à jetons par
+ * session, en bits, et tourniquet à déficit pour l'ordre de libération
+ * des acquittements retenus. Sans -R, les acquittements partent
+ * immédiatement comme avant. Les jetons sont comptés en bits × 10^9
+ * pour qu'un remplissage de quelques nanosecondes ne soit pas arrondi
+ * à zéro. Une session neuve part d'un seau vide : un client ne peut
+ * pas regagner une rafale entière en ouvrant un nouveau message.
+ */
+# define SCHED_BURST 4096
+# define SCHED_QUANTUM 256
+# define SCHED_SCALE 1000000000L
+# define USAGE_SERVER "Usage: ./server_bonus [-R bits/s] [-B bits] [-Q bits]"
+
+/*
+ * Octet de contrôle placé en tête de message : 0xF8 à 0xFF n'apparaissent
+ * jamais dans un texte UTF-8 valide. Un message en clair qui commence
+ * quand même par l'un d'eux est précédé de CTL_ESC : le serveur retire
+ * l'échappement et affiche l'octet suivant tel quel.
+ */
+# define CTL_ESC 0xFF
+# define CTL_LANE 0xFD
+# define CTL_SHM 0xFC
+# define CTL_LZ 0xFB
+# define CTL_HUF 0xFA
+# define CTL_FRAME 0xF9
+# define CTL_SYM 0xF8
+
+/*
+ * Alphabet de symboles (-a N). Après CTL_SYM, le client propose sur un
+ * octet le nombre de bits par symbole ; le serveur répond sur
+ * SIGRTMIN + RT_ACK avec le nombre retenu, borné par les signaux temps
+ * réel dont il dispose. Le symbole s voyage ensuite sur
+ * SIGRTMIN + RT_SYM + s, sans valeur attachée.
+ */
+# define SYM_MAX_BITS 5
+
+// Étapes de la réception par symboles d'une session
+# define SYM_IDLE 0
+# define SYM_PROPOSE 1
+# define SYM_DATA 2
+
+/*
+ * Transfert en voies parallèles (-j N). Chaque voie est un processus
+ * fils ; après CTL_LANE, elle envoie un en-tête de LANE_HEADER octets
+ * [PID du parent:4 | voie:1 | nombre de voies:1 | taille:4], poids fort
+ * d'abord, puis son morceau. Le serveur range les morceaux par voie et
+ * n'affiche le message qu'une fois toutes les voies reçues.
+ */
+# define LANE_MAX 16
+# define LANE_GROUPS 16
+# define LANE_HEADER 10
+
+// Étapes de la réception d'une voie
+# define LANE_IDLE 0
+# define LANE_HEAD 1
+# define LANE_DATA 2
+
+/*
+ * Trame à longueur préfixée (-l). Après CTL_FRAME viennent la taille en
+ * varint (7 bits par octet, poids faible d'abord, bit 7 = suite) puis
+ * un octet de drapeaux ; suivent exactement autant d'octets quelconques,
+ * '\0' compris, sans terminateur.
+ */
+# define FRAME_MAX_LEN 1073741824
+# define FRAME_VARINT_MAX 10
+// Drapeau : une autre trame suit dans le même message (-f)
+# define FRAME_F_MORE 0x01
+// Drapeau : fin d'un enregistrement, la session reste ouverte (-b)
+# define FRAME_F_NEXT 0x02
+# define FRAME_FLAGS_KNOWN 0x03
+
+// Étapes du récepteur de trame d'une session
+# define FRAME_IDLE 0
+# define FRAME_LEN 1
+# define FRAME_FLAGS 2
+# define FRAME_DATA 3
+
+/*
+ * Compression LZ77 (-z). Après CTL_LZ vient un en-tête de LZ_HEADER
+ * octets [codec:1 | taille brute:4 | taille compressée:4], poids fort
+ * d'abord, puis le flux compressé ; aucun '\0' terminal n'est envoyé.
+ * Flux : 0LLLLLLL annonce L + 1 littéraux, 1LLLLLLL une copie de
+ * L + LZ_MIN_MATCH octets suivie de son décalage sur 2 octets.
+ */
+# define LZ_CODEC 1
+# define LZ_HEADER 9
+# define LZ_WINDOW 4096
+# define LZ_MIN_MATCH 4
+# define LZ_MAX_MATCH 131
+# define LZ_MAX_LITERALS 128
+# define LZ_HASH_BITS 12
+
+/*
+ * Codage de Huffman canonique (-H). Après CTL_HUF, le flux est lu bit
+ * par bit : nombre de symboles moins un (8 bits), puis pour chacun
+ * [symbole:8 | longueur:4] dans l'ordre canonique (longueur, symbole),
+ * enfin les codes du texte, '\0' terminal compris.
+ */
+# define HUF_SYMBOLS 256
+# define HUF_MAX_LEN 15
+# define HUF_ENTRY_BITS 12
+
+// Étapes du décodeur de Huffman d'une session
+# define HUF_IDLE 0
+# define HUF_COUNT 1
+# define HUF_ENTRY 2
+# define HUF_DATA 3
+
+// Étapes du décodeur LZ d'une session
+# define LZ_IDLE 0
+# define LZ_HEAD 1
+# define LZ_TOKEN 2
+# define LZ_LIT 3
+# define LZ_OFF_HI 4
+# define LZ_OFF_LO 5
+
+// Anneau en mémoire partagée (-m) : capacité en octets, puissance de 2
+# define SHM_RING_SIZE 1048576
+// Nom du segment : "/minitalk_<pid serveur>_<pid client>"
+# define SHM_NAME_MAX 48
+
+/*
+ * Lecture d'un fichier ou de l'entrée standard (-f) : deux tampons de
+ * STREAM_CHUNK octets, l'un envoyé pendant que l'autre se remplit.
+ */
+# ifndef STREAM_CHUNK
+#  define STREAM_CHUNK 65536
+# endif
+
+# define USAGE_BONUS "Usage: ./client_bonus [pid]" \
+	" [msg | -f path | -b [msg ...]]" \
+	" [-v] [-r] [-w N] [-m] [-z] [-H] [-l] [-a N] [-j N] [-J]"
+
+/*
+ * Histogramme des RTT du client, à la manière de HdrHistogram : une
+ * ligne par puissance de 2, découpée en 2^HIST_SUB_BITS sous-classes
+ * linéaires (erreur relative inférieure à 1 / 2^HIST_SUB_BITS).
+ */
+# define HIST_SUB_BITS 4
+# define HIST_BUCKETS 1024
 
 // Codes ANSI pour les couleurs
 # define COLOR_GREEN "\033[1;32m"
@@ -32,26 +248,461 @@
 
 /**
  * @brief Structure pour les statistiques de transmission
+ * 
+ * Compteurs sur 64 bits quelle que soit la plateforme : une session de
+ * plusieurs Gio dépasse 2^32 bits. Les instants viennent de
+ * CLOCK_MONOTONIC, relevés par le gestionnaire à l'arrivée du signal.
  */
 typedef struct s_stats
 {
-	size_t	chars_received;	/* Nombre de caractères reçus */
-	size_t	bits_received;	/* Nombre total de bits reçus */
-	pid_t	client_pid;		/* PID du client actuel */
-	int		verbose_mode;	/* Mode verbeux activé/désactivé */
+	uint64_t	chars_received;	/* Nombre de caractères reçus */
+	uint64_t	bits_received;	/* Nombre total de bits reçus */
+	uint64_t	start;			/* Arrivée du premier signal, en ns */
+	uint64_t	end;			/* Arrivée du dernier signal, en ns */
+	uint64_t	max_gap;		/* Plus longue attente entre deux signaux */
+	pid_t		client_pid;		/* PID du client actuel */
+	int			verbose_mode;	/* Mode verbeux activé/désactivé */
 }	t_stats;
 
+/**
+ * @brief Tampon de sortie unique du programme
+ */
+typedef struct s_out
+{
+	char					buf[OUT_BUF_SIZE];	/* Octets non écrits */
+	size_t					len;				/* Octets occupés dans buf */
+	struct itimerval		timer;				/* Délai OUT_FLUSH_MS */
+	volatile sig_atomic_t	busy;				/* Mise à jour en cours */
+	volatile sig_atomic_t	late;				/* Délai écoulé pendant busy */
+}	t_out;
+
+/**
+ * @brief Anneau d'octets SPSC partagé entre un client et le serveur
+ * 
+ * head et tail sont des compteurs absolus : l'anneau est vide quand ils
+ * sont égaux, plein quand tail - head vaut size. Seul le client écrit
+ * tail, seul le serveur écrit head ; aucun verrou n'est nécessaire.
+ */
+typedef struct s_ring
+{
+	_Atomic size_t	head;		/* Octets consommés par le serveur */
+	_Atomic size_t	tail;		/* Octets publiés par le client */
+	_Atomic int		waiting;	/* Le client attend de la place */
+	size_t			size;		/* Capacité de data, puissance de 2 */
+	unsigned char	data[];		/* Octets du message */
+}	t_ring;
+
+/**
+ * @brief Signal reçu par le serveur, en attente de décodage
+ */
+typedef struct s_sigev
+{
+	pid_t		pid;	/* Émetteur (si_pid) */
+	int			sig;	/* Numéro du signal */
+	int			value;	/* Valeur attachée (si_value.sival_int) */
+	uint64_t	time;	/* Arrivée, CLOCK_MONOTONIC en ns */
+}	t_sigev;
+
+/**
+ * @brief File SPSC entre le gestionnaire de signaux et la boucle principale
+ * 
+ * Même discipline que t_ring : compteurs absolus, tail écrit par le seul
+ * gestionnaire, head par la seule boucle principale. Les compteurs font
+ * 32 bits pour que la boucle puisse attendre sur tail avec un futex ;
+ * SIGQ_SIZE divisant 2^32, leur débordement est sans effet. lost est
+ * incrémenté par le gestionnaire et remis à zéro par la boucle : il
+ * est atomique pour qu'aucune perte ne se perde entre les deux.
+ */
+typedef struct s_sigq
+{
+	_Atomic unsigned int	head;			/* Entrées décodées */
+	_Atomic unsigned int	tail;			/* Entrées publiées */
+	_Atomic unsigned int	lost;			/* Signaux perdus, file pleine */
+	t_sigev					ev[SIGQ_SIZE];	/* Signaux en attente */
+}	t_sigq;
+
+/**
+ * @brief Décodeur LZ incrémental d'une session (-z)
+ * 
+ * Les octets compressés sont décodés au fil de l'eau dans le
+ * gestionnaire : seule la fenêtre des LZ_WINDOW derniers octets
+ * produits est conservée, aucune allocation n'est nécessaire.
+ */
+typedef struct s_lz
+{
+	int				state;				/* Étape LZ_IDLE .. LZ_OFF_LO */
+	int				count;				/* Littéraux ou octets à copier */
+	unsigned int	offset;				/* Décalage de la copie en cours */
+	size_t			head_len;			/* Octets d'en-tête reçus */
+	uint32_t		raw_len;			/* Taille annoncée du texte */
+	uint32_t		left;				/* Octets compressés attendus */
+	size_t			pos;				/* Octets produits jusqu'ici */
+	unsigned char	hist[LZ_WINDOW];	/* Derniers octets produits */
+}	t_lz;
+
+/**
+ * @brief Décodeur de Huffman canonique d'une session (-H)
+ * 
+ * Décodage à la manière de puff (zlib) : chaque bit prolonge le code
+ * courant, comparé en temps constant aux codes de sa longueur. Aucune
+ * table n'est construite : l'en-tête arrive déjà dans l'ordre canonique.
+ */
+typedef struct s_huff
+{
+	int				state;					/* HUF_IDLE .. HUF_DATA */
+	int				nsym;					/* Symboles annoncés */
+	int				got;					/* Entrées d'en-tête reçues */
+	int				field;					/* Champ d'en-tête en cours */
+	int				field_bits;				/* Bits reçus de ce champ */
+	int				code;					/* Code en cours de décodage */
+	int				first;					/* Premier code de la longueur */
+	int				index;					/* Premier symbole de la longueur */
+	int				len;					/* Longueur du code en cours */
+	unsigned short	count[HUF_MAX_LEN + 1];	/* Codes par longueur */
+	unsigned char	symbol[HUF_SYMBOLS];	/* Symboles, ordre canonique */
+}	t_huff;
+
+/**
+ * @brief Réception d'une trame à longueur préfixée (-l)
+ * 
+ * Dès que la taille est connue, un tampon de exactement len octets est
+ * réservé : le contenu y est copié sans examen puis remis d'un seul
+ * bloc au tampon de sortie.
+ */
+typedef struct s_frame
+{
+	int				state;		/* FRAME_IDLE .. FRAME_DATA */
+	int				shift;		/* Décalage du prochain groupe du varint */
+	int				flags;		/* Drapeaux annoncés */
+	size_t			len;		/* Taille annoncée */
+	size_t			got;		/* Octets reçus */
+	unsigned char	*buf;		/* Tampon réservé, ou NULL */
+	size_t			seps;		/* Fins d'enregistrement pas encore écrites */
+}	t_frame;
+
+/**
+ * @brief Tampon de réordonnancement d'un message en voies parallèles (-j)
+ * 
+ * Un groupe par client parent : chaque voie dépose son morceau dans
+ * l'emplacement de son numéro, quel que soit l'ordre d'arrivée.
+ */
+typedef struct s_lanes
+{
+	pid_t			owner;			/* PID du client parent, 0 si libre */
+	int				count;			/* Voies annoncées */
+	int				done;			/* Voies entièrement reçues */
+	int				seen;			/* Masque des voies annoncées */
+	int				failed;			/* Un morceau n'a pas pu être réservé */
+	size_t			len[LANE_MAX];	/* Taille de chaque morceau */
+	unsigned char	*buf[LANE_MAX];	/* Morceaux, dans l'ordre des voies */
+	t_stats			stats;			/* Statistiques cumulées des voies */
+}	t_lanes;
+
+/**
+ * @brief Réception d'une voie par la session de son processus (-j)
+ */
+typedef struct s_lane
+{
+	int				state;				/* LANE_IDLE .. LANE_DATA */
+	int				head_len;			/* Octets d'en-tête reçus */
+	unsigned char	head[LANE_HEADER];	/* En-tête de la voie */
+	t_lanes			*group;				/* Groupe, NULL si voie rejetée */
+	int				idx;				/* Numéro de la voie */
+	size_t			len;				/* Taille annoncée du morceau */
+	size_t			got;				/* Octets reçus */
+}	t_lane;
+
+/**
+ * @brief Seau à jetons et acquittement retenu d'une session
+ */
+typedef struct s_sched
+{
+	uint64_t	stamp;		/* Dernier remplissage du seau (ns) */
+	long		tokens;		/* Jetons (bits × SCHED_SCALE), < 0 : dette */
+	long		deficit;	/* Crédit du tourniquet, en bits */
+	long		owed;		/* Bits couverts par l'acquittement retenu */
+	size_t		billed;		/* bits_received déjà facturés */
+	int			ack_sig;	/* Acquittement retenu, 0 si aucun */
+	int			ack_value;	/* Valeur de l'acquittement (sigqueue) */
+}	t_sched;
+
+/**
+ * @brief Limites fixées au lancement du serveur
+ */
+typedef struct s_sched_conf
+{
+	long	rate;		/* Débit par client en bits/s, 0 : illimité */
+	long	burst;		/* Capacité du seau en bits */
+	long	quantum;	/* Bits accordés par tour du tourniquet */
+	size_t	cursor;		/* Premier emplacement visité au prochain tour */
+}	t_sched_conf;
+
+/**
+ * @brief État de réassemblage propre à un client du serveur
+ * 
+ * Une entrée par PID émetteur dans une table à adressage ouvert de
+ * SESSION_MAX emplacements : les bits de deux clients simultanés ne
+ * peuvent plus se mélanger dans le même octet.
+ */
+typedef struct s_session
+{
+	pid_t			pid;				/* 0 si l'emplacement est libre */
+	int				done;				/* Message terminé, à libérer */
+	int				bit_count;			/* Bits reçus du caractère en cours */
+	unsigned char	c;					/* Caractère en reconstruction */
+	int				next_seq;			/* Prochaine unité attendue (-w) */
+	int				bit_seq;			/* Prochain bit, mot ou symbole */
+	size_t			msg_bytes;			/* Octets reçus du message en cours */
+	int				sym_state;			/* SYM_IDLE .. SYM_DATA (-a) */
+	int				sym_bits;			/* Bits par symbole retenus */
+	t_ring			*ring;				/* Anneau partagé (-m), ou NULL */
+	size_t			out_len;			/* Octets en attente dans out */
+	char			out[SESSION_BUF];	/* Texte reçu pas encore affiché */
+	t_stats			stats;				/* Statistiques du message */
+	t_lz			lz;					/* Décodeur du mode compressé */
+	t_huff			huff;				/* Décodeur du mode Huffman */
+	t_frame			frame;				/* Trame à longueur préfixée */
+	t_lane			lane;				/* Voie d'un transfert parallèle */
+	t_sched			sched;				/* Limite de débit du client */
+}	t_session;
+
+/**
+ * @brief Mesures des allers-retours signal / acquittement du client
+ * 
+ * Taille fixe : un échantillon coûte un incrément de compteur, sans
+ * allocation ni tri.
+ */
+typedef struct s_hist
+{
+	uint32_t	count[HIST_BUCKETS];	/* Échantillons par classe */
+	uint64_t	samples;				/* Nombre d'échantillons */
+	uint64_t	min;					/* RTT minimal (ns) */
+	uint64_t	max;					/* RTT maximal (ns) */
+	uint64_t	sum;					/* Somme des RTT (ns) */
+	uint64_t	first;					/* Premier envoi (ns) */
+	uint64_t	last;					/* Dernier acquittement (ns) */
+	uint64_t	bits;					/* Bits acquittés */
+	uint64_t	cwnd;					/* Fenêtre finale (-w), 0 sinon */
+	uint64_t	cwnd_max;				/* Plus grande fenêtre atteinte */
+	uint64_t	srtt;					/* RTT lissé final (ns) */
+}	t_hist;
+
+/**
+ * @brief Lecture anticipée d'un fichier par morceaux (-f)
+ * 
+ * Pendant l'envoi du morceau rendu par ft_stream_next, la lecture du
+ * suivant est déjà en cours (aio_read) dans l'autre tampon : la
+ * mémoire reste bornée à deux morceaux quelle que soit la taille.
+ */
+typedef struct s_stream
+{
+	struct aiocb	cb;						/* Lecture en cours */
+	unsigned char	buf[2][STREAM_CHUNK];	/* Double tampon */
+	int				cur;					/* Tampon en cours de lecture */
+	int				fd;						/* Fichier, ou 0 pour stdin */
+	off_t			off;					/* Position de la lecture */
+}	t_stream;
+
+/**
+ * @brief Options de la ligne de commande du client bonus
+ */
+typedef struct s_opts
+{
+	int		verbose;		/* -v : affichage de chaque envoi */
+	int		rt;				/* -r : transport temps réel (sigqueue) */
+	int		window;			/* -w N : unités en vol, 0 si désactivé */
+	int		shm;			/* -m : anneau en mémoire partagée */
+	int		json;			/* -J : statistiques finales en JSON */
+	int		lz;				/* -z : compression LZ77 du message */
+	int		huff;			/* -H : codage de Huffman canonique */
+	int		frame;			/* -l : trame à longueur préfixée */
+	int		alphabet;		/* -a N : bits par symbole, 0 si désactivé */
+	int		lanes;			/* -j N : processus d'envoi, 0 si désactivé */
+	char	*file;			/* -f path : fichier à envoyer, "-" pour stdin */
+	char	**batch;		/* -b : messages du lot, NULL hors de ce mode */
+	int		batch_len;		/* -b : nombre de messages, 0 pour stdin */
+}	t_opts;
+
+/**
+ * @brief État du compresseur LZ du client
+ * 
+ * table associe le hachage de LZ_MIN_MATCH octets à leur dernière
+ * position dans src, plus un (0 pour un emplacement vide).
+ */
+typedef struct s_lzenc
+{
+	const unsigned char	*src;						/* Texte à compresser */
+	size_t				len;						/* Taille de src */
+	unsigned char		*dst;						/* Flux produit */
+	size_t				out;						/* Octets écrits dans dst */
+	size_t				lit;						/* Début des littéraux */
+	size_t				table[1 << LZ_HASH_BITS];	/* Dernières positions */
+}	t_lzenc;
+
+/**
+ * @brief Code de Huffman canonique calculé par le client
+ */
+typedef struct s_huffenc
+{
+	size_t			freq[HUF_SYMBOLS];	/* Occurrences, '\0' compris */
+	int				len[HUF_SYMBOLS];	/* Longueur du code, 0 si absent */
+	unsigned int	code[HUF_SYMBOLS];	/* Code canonique */
+	int				order[HUF_SYMBOLS];	/* Symboles présents, ordre canonique */
+	int				n;					/* Nombre de symboles présents */
+}	t_huffenc;
+
+/**
+ * @brief Contrôleur AIMD de la fenêtre glissante (-w)
+ * 
+ * srtt et rttvar suivent l'estimateur de Jacobson/Karels (RFC 6298), en
+ * nanosecondes, comme le lien du client obligatoire.
+ */
+typedef struct s_cc
+{
+	size_t	cwnd;		/* Unités autorisées en vol */
+	size_t	cwnd_max;	/* Plus grande fenêtre atteinte */
+	size_t	cap;		/* Plafond : -w N borné par le système */
+	size_t	ssthresh;	/* Fin du démarrage lent */
+	size_t	acc;		/* Unités acquittées depuis la dernière hausse */
+	size_t	base;		/* Plus ancienne unité non acquittée connue */
+	size_t	recover;	/* Aucune nouvelle baisse avant cette unité */
+	long	srtt;		/* RTT lissé, 0 avant la première mesure */
+	long	rttvar;		/* Variation moyenne du RTT */
+	long	min_rtt;	/* Plus petit RTT lissé observé */
+	long	rto;		/* Attente maximale d'un acquittement */
+}	t_cc;
+
+/**
+ * @brief État de l'émetteur à fenêtre glissante (-w)
+ * 
+ * Les compteurs sont absolus ; seuls leurs 16 bits de poids faible
+ * circulent sur le fil comme numéros de séquence.
+ */
+typedef struct s_window
+{
+	pid_t		pid;		/* PID du serveur destinataire */
+	const char	*message;	/* Message à transmettre */
+	size_t		len;		/* Longueur du message, '\0' exclu */
+	size_t		base;		/* Plus ancienne unité non acquittée */
+	size_t		next;		/* Prochaine unité à envoyer */
+	size_t		high;		/* Unités déjà envoyées au moins une fois */
+	size_t		karn;		/* high au dernier retour : RTT ambigu avant */
+	size_t		total;		/* Nombre d'unités du message, '\0' compris */
+	size_t		size;		/* Plafond des unités en vol */
+	uint64_t	*sent;		/* Envoi de chaque unité en vol, modulo size */
+	t_cc		cc;			/* Contrôleur de la fenêtre */
+}	t_window;
+
+/*
+ * État de la reprise des modes bit par bit, -r et -a, unique pour le
+ * client : le numéro du prochain envoi et l'estimateur du RTO
+ * survivent d'un message et d'un mode à l'autre, comme la session
+ * côté serveur.
+ */
+typedef struct s_retx
+{
+	sigset_t	set;		/* SIGUSR1 et SIGUSR2, bloqués pendant l'attente */
+	int			seq;		/* Numéro du prochain envoi, sur 16 bits */
+	t_cc		cc;			/* Estimateur du RTO (srtt, rttvar, rto) */
+}	t_retx;
+
 // Fonctions utilitaires
-void	ft_putchar_bonus(char c);
-void	ft_putstr_bonus(const char *str);
-void	ft_putnbr_bonus(int n);
-int		ft_atoi_bonus(const char *str);
-void	ft_print_stats(t_stats *stats);
-void	ft_print_colored(const char *msg, const char *color);
+void		ft_out_init_bonus(void);
+void		ft_out_flush_bonus(void);
+void		ft_out_write_bonus(const char *buf, size_t len);
+void		ft_putchar_bonus(char c);
+void		ft_putstr_bonus(const char *str);
+void		ft_putnbr_bonus(int n);
+int			ft_atoi_bonus(const char *str);
+void		ft_print_colored(const char *msg, const char *color);
+void		ft_shm_name(char *name, pid_t server, pid_t client);
+uint64_t	ft_now_ns(void);
+void		ft_putnbr_u64_bonus(uint64_t n);
+size_t		ft_strlen_bonus(const char *str);
+uint64_t	ft_per_sec(uint64_t count, uint64_t ns);
+void		ft_trace_init_bonus(void);
+void		ft_trace_rec_bonus(int what, pid_t peer, int value);
+
+// Fonctions serveur bonus
+void		ft_stats_reset(t_stats *stats, pid_t pid);
+void		ft_stats_tick(t_stats *stats, uint64_t now);
+void		ft_stats_merge(t_stats *dst, const t_stats *src);
+void		ft_print_stats(t_stats *stats);
+void		ft_sigq_push(pid_t pid, int sig, int value);
+int			ft_sigq_pop(t_sigev *ev);
+void		ft_sigq_wait(long timeout_ns);
+t_sched_conf	*ft_sched_conf(void);
+void		ft_sched_ack(t_session *s, int sig, int value);
+long		ft_sched_run(void);
+void		ft_handle_char_bonus(unsigned char c, t_session *s);
+void		ft_handle_new_client(t_session *s);
+void		ft_receive_bit_bonus(int sig, t_session *s);
+void		ft_receive_word_bonus(unsigned int word, t_session *s);
+void		ft_receive_seq_bonus(unsigned int unit, t_session *s);
+void		ft_session_flush(t_session *s);
+t_session	*ft_session_table(void);
+t_session	*ft_session_get(pid_t pid);
+void		ft_session_remove(t_session *s);
+void		ft_shm_attach(t_session *s);
+void		ft_shm_drain(t_session *s);
+void		ft_shm_release(t_session *s);
+void		ft_lz_start(t_session *s);
+void		ft_lz_feed(unsigned char c, t_session *s);
+void		ft_huff_start(t_session *s);
+void		ft_huff_bit(int bit, t_session *s);
+void		ft_frame_start(t_session *s);
+void		ft_frame_feed(unsigned char c, t_session *s);
+void		ft_frame_release(t_session *s);
+int			ft_sym_max_bits(void);
+void		ft_sym_start(t_session *s);
+int			ft_sym_accept(unsigned char bits, t_session *s);
+void		ft_receive_sym_bonus(int sym, t_session *s);
+void		ft_lane_start(t_session *s);
+void		ft_lane_feed(unsigned char c, t_session *s);
+t_lanes		*ft_lanes_get(pid_t owner, int count);
+void		ft_lanes_emit(t_lanes *g);
 
 // Fonctions client bonus
-void	ft_send_bit_bonus(pid_t pid, int bit_val, int verbose);
-void	ft_send_char_bonus(pid_t pid, unsigned char c, int verbose);
-void	ft_send_message_bonus(pid_t pid, const char *message, int verbose);
+void		ft_send_bit_bonus(pid_t pid, int bit_val, int verbose);
+void		ft_send_char_bonus(pid_t pid, unsigned char c, int verbose);
+void		ft_send_message_bonus(pid_t pid, const char *message, int verbose);
+void		ft_send_message_rt_bonus(pid_t pid, const char *message, int verbose);
+void		ft_send_message_window_bonus(pid_t pid, const char *message,
+				t_opts *opts);
+void		ft_send_message_shm_bonus(pid_t pid, const char *message, int verbose);
+void		ft_send_message_lz_bonus(pid_t pid, const char *message,
+				int verbose);
+void		ft_send_message_huff_bonus(pid_t pid, const char *message,
+				int verbose);
+void		ft_send_frame_bonus(pid_t pid, const void *buf, size_t len,
+				int verbose);
+void		ft_send_frame_head_bonus(pid_t pid, size_t len, int flags,
+				int verbose);
+void		ft_send_bytes_bonus(pid_t pid, const void *data, size_t len,
+				int verbose);
+void		ft_send_words_bonus(pid_t pid, const void *data, size_t len,
+				int verbose);
+void		ft_send_file_bonus(pid_t pid, const char *path, int verbose);
+void		ft_send_batch_bonus(pid_t pid, t_opts *opts);
+void		ft_send_message_sym_bonus(pid_t pid, const char *message,
+				t_opts *opts);
+int			ft_sym_bits(int n);
+void		ft_send_lanes_bonus(pid_t pid, const char *message, t_opts *opts);
+int			ft_stream_open(t_stream *st, const char *path);
+ssize_t		ft_stream_next(t_stream *st, const unsigned char **data);
+size_t		ft_lz_compress(t_lzenc *z, const char *src, size_t len,
+				unsigned char *dst);
+void		ft_wait_done(void);
+t_hist		*ft_hist(void);
+void		ft_hist_reset(void);
+void		ft_hist_record(uint64_t sent, uint64_t acked, int bits);
+uint64_t	ft_hist_percentile(t_hist *h, int permille);
+void		ft_report_print(int json);
+void		ft_cc_init(t_cc *cc, size_t cap);
+void		ft_cc_ack(t_cc *cc, size_t base, long rtt, int verbose);
+void		ft_cc_cut(t_cc *cc, size_t next, int timeout, int verbose);
+void		ft_cc_rtt(t_cc *cc, long rtt);
+void		ft_retx_send(pid_t pid, int sig);
+void		ft_retx_unit(pid_t pid, int sig, unsigned int data, int bits);
 
 #endif
@@ -0,0 +1,87 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   libminitalk.h                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fdi-tria <fdi-tria@student.42lausanne.c    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 11:12:30 by fdi-tria          #+#    #+#             */
+/*   Updated: 2026/10/16 15:47:05 by fdi-tria         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef LIBMINITALK_H
+# define LIBMINITALK_H
+
+# include <stddef.h>
+# include <sys/types.h>
+
+/*
+ * Interface publique de libminitalk (libminitalk.a, libminitalk.so) :
+ * le protocole du client et du serveur obligatoires, sans processus
+ * intermédiaire. client et server n'en sont que des enveloppes.
+ */
+
+/*
+ * Seules les fonctions marquées MT_API sortent de la bibliothèque : le
+ * reste est compilé avec -fvisibility=hidden, puis rendu local dans
+ * libminitalk.a (objcopy --localize-hidden). ft_atoi, ft_putstr et les
+ * autres aides internes n'entrent donc pas en conflit avec celles du
+ * programme hôte.
+ */
+# define MT_API __attribute__((visibility("default")))
+
+// Transport choisi par mt_send : bit par bit, mots de 3 octets, blocs CRC32C
+# define MT_BIT 0
+# define MT_WORD 1
+# define MT_BLOCK 2
+
+/*
+ * Transport des signaux : noyau (sigqueue, sigtimedwait), ou boucle
+ * locale qui remet chaque signal au décodeur du serveur dans le même
+ * processus, sans noyau, pour mesurer le codage seul.
+ */
+# define MT_SIGNAL 0
+# define MT_LOOPBACK 1
+
+// Codes de retour : 0 si le serveur a confirmé le message entier
+# define MT_OK 0
+# define MT_ESEND -1
+# define MT_ETIMEOUT -2
+# define MT_EINVAL -3
+# define MT_EFILE -4
+# define MT_ENOMEM -5
+// État d'un destinataire de mt_broadcast tant que son envoi est en cours
+# define MT_PENDING 1
+
+/**
+ * @brief Options d'envoi de mt_send
+ */
+typedef struct s_mt_opts
+{
+	int	mode;		/* MT_BIT, MT_WORD ou MT_BLOCK */
+	int	transport;	/* MT_SIGNAL, ou MT_LOOPBACK (mt_send seulement) */
+}	t_mt_opts;
+
+/**
+ * @brief Destinataire de mt_broadcast et résultat de son envoi
+ */
+typedef struct s_mt_dest
+{
+	pid_t	pid;	/* PID du serveur destinataire */
+	int		status;	/* MT_OK, ou l'erreur propre à ce destinataire */
+}	t_mt_dest;
+
+/*
+ * Appelé une fois par message complet, hors gestionnaire de signaux :
+ * msg n'est valide que pendant l'appel et n'est pas terminé par '\0'.
+ */
+typedef void	(*t_mt_on_message)(pid_t pid, const char *msg, size_t len);
+
+MT_API int	mt_send(pid_t pid, const void *buf, size_t len,
+				const t_mt_opts *opts);
+MT_API int	mt_broadcast(t_mt_dest *dests, size_t n, const char *msg,
+				const t_mt_opts *opts);
+MT_API int	mt_server_run(t_mt_on_message on_message);
+
+#endif
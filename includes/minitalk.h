@@ -6,7 +6,7 @@
 /*   By: fdi-tria <fdi-tria@student.42lausanne.c    +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/01/25 19:21:40 by fdi-tria          #+#    #+#             */
-/*   Updated: 2025/01/25 19:21:41 by fdi-tria         ###   ########.fr       */
+/*   Updated: 2026/10/16 15:20:00 by fdi-tria         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -17,13 +17,389 @@
 # include <unistd.h>
 # include <stdlib.h>
 # include <sys/types.h>
+# include <sys/time.h>
+# include <aio.h>
+# include <stdint.h>
+# include "libminitalk.h"
+# include "trace.h"
+
+/*
+ * Tampon de sortie : taille et délai maximal avant vidage, modifiables
+ * à la compilation (-DOUT_BUF_SIZE=... -DOUT_FLUSH_MS=...). Un délai nul
+ * désactive le vidage périodique.
+ */
+# ifndef OUT_BUF_SIZE
+#  define OUT_BUF_SIZE 4096
+# endif
+# ifndef OUT_FLUSH_MS
+#  define OUT_FLUSH_MS 50
+# endif
+
+/*
+ * Lecture d'un fichier ou de l'entrée standard (-f) : deux tampons de
+ * STREAM_CHUNK octets, l'un envoyé pendant que l'autre se remplit.
+ */
+# ifndef STREAM_CHUNK
+#  define STREAM_CHUNK 65536
+# endif
+
+/*
+ * Retransmission du client : délai initial, bornes du délai adaptatif
+ * (RTO, en microsecondes) et nombre de retransmissions successives
+ * avant d'abandonner. Modifiables à la compilation (-D).
+ */
+# ifndef LINK_RTO_INIT_US
+#  define LINK_RTO_INIT_US 200000
+# endif
+# ifndef LINK_RTO_MIN_US
+#  define LINK_RTO_MIN_US 1000
+# endif
+# ifndef LINK_RTO_MAX_US
+#  define LINK_RTO_MAX_US 1000000
+# endif
+# ifndef LINK_RETX_MAX
+#  define LINK_RETX_MAX 30
+# endif
+
+// Unités de ft_link_send : bit, mot de 3 octets (-r), bloc contrôlé (-c)
+# define LINK_BIT MT_BIT
+# define LINK_WORD MT_WORD
+# define LINK_BLOCK MT_BLOCK
+// ft_link_send : unité acquittée (RT_ACK), ou message confirmé (RT_DONE)
+# define LINK_ACKED 0
+# define LINK_DONE 1
+
+// Capacité initiale du message remis à mt_server_run, doublée au besoin
+# define MSG_INIT_CAP 256
+
+/*
+ * Blocs contrôlés (-c) : BLOCK_BYTES octets par bloc, transportés en
+ * mots de 32 bits sur SIGRTMIN + RT_BLOCK puis le CRC32C, mêlé au
+ * numéro du bloc, sur SIGRTMIN + RT_BLOCK_CRC. Un seul acquittement
+ * par bloc.
+ */
+# define BLOCK_BYTES 64
+# define BLOCK_WORDS 16
+# define RT_BLOCK 1
+# define RT_BLOCK_CRC 2
+# define CRC32C_POLY 0x82F63B78
+
+/*
+ * Acquittements du serveur : SIGRTMIN + RT_ACK par unité (~seq pour un
+ * bloc rejeté), SIGRTMIN + RT_DONE en fin de message. Temps réel pour
+ * être mis en file : plusieurs serveurs qui répondent au même client
+ * (mt_broadcast) ne voient pas leurs acquittements fusionnés.
+ */
+# define RT_ACK 3
+# define RT_DONE 4
+
+// Diffusion : intervalle de la recherche des unités à retransmettre
+# ifndef FAN_TICK_US
+#  define FAN_TICK_US LINK_RTO_MIN_US
+# endif
+
+// Boucle d'événements du serveur (-e) : descripteurs surveillés, lots lus
+# define LOOP_MAX_WATCH 16
+# define LOOP_MAX_EVENTS 16
+# define LOOP_SIG_BATCH 64
+
+// Boucle locale (MT_LOOPBACK) : acquittements en attente du client
+# define LOOPBACK_ACKS 64
+
+// mt-codec : passes de mesure sur le même message
+# ifndef CODEC_PASSES
+#  define CODEC_PASSES 8
+# endif
+
+// mt-trace : couples client/serveur suivis, étapes d'un aller-retour
+# define TRACE_FLOWS 64
+# define TRACE_STAGES 4
+
+/**
+ * @brief Tampon de sortie unique du programme
+ */
+typedef struct s_out
+{
+	char					buf[OUT_BUF_SIZE];	/* Octets non écrits */
+	size_t					len;				/* Octets occupés dans buf */
+	struct itimerval		timer;				/* Délai OUT_FLUSH_MS */
+	volatile sig_atomic_t	busy;				/* Mise à jour en cours */
+	volatile sig_atomic_t	late;				/* Délai écoulé pendant busy */
+}	t_out;
+
+/**
+ * @brief Lecture anticipée d'un fichier par morceaux (-f)
+ * 
+ * Pendant l'envoi du morceau rendu par ft_stream_next, la lecture du
+ * suivant est déjà en cours (aio_read) dans l'autre tampon : la
+ * mémoire reste bornée à deux morceaux quelle que soit la taille.
+ */
+typedef struct s_stream
+{
+	struct aiocb	cb;						/* Lecture en cours */
+	unsigned char	buf[2][STREAM_CHUNK];	/* Double tampon */
+	int				cur;					/* Tampon en cours de lecture */
+	int				fd;						/* Fichier, ou 0 pour stdin */
+	off_t			off;					/* Position de la lecture */
+}	t_stream;
+
+/**
+ * @brief État de la liaison côté client : séquence et délai adaptatif
+ * 
+ * srtt et rttvar suivent l'estimateur de Jacobson/Karels (RFC 6298),
+ * en nanosecondes : rto = srtt + 4 * rttvar, borné par LINK_RTO_*.
+ */
+typedef struct s_link
+{
+	sigset_t	set;	/* RT_ACK et RT_DONE, bloqués puis attendus */
+	pid_t		pid;	/* Serveur destinataire */
+	int			seq;	/* Numéro de la prochaine unité */
+	int			msgs;	/* Messages commencés par le processus */
+	long		srtt;	/* RTT lissé, 0 avant la première mesure */
+	long		rttvar;	/* Variation moyenne du RTT */
+	long		rto;	/* Délai avant retransmission */
+}	t_link;
+
+/**
+ * @brief Découpage d'un message en unités (bits, mots ou blocs)
+ * 
+ * Les lead premiers octets partent bit par bit, '\0' terminal compris
+ * s'il en fait partie ; le reste suit le mode choisi.
+ */
+typedef struct s_pack
+{
+	const char	*buf;	/* Message, sans '\0' */
+	size_t		len;	/* Longueur du message */
+	size_t		i;		/* Prochain octet à découper */
+	size_t		lead;	/* Octets restant à envoyer bit par bit */
+	int			bit;	/* Bits déjà envoyés de l'octet i */
+	int			done;	/* '\0' terminal découpé */
+	int			mode;	/* LINK_BIT, LINK_WORD ou LINK_BLOCK */
+	int			kind;	/* Mode de la dernière unité découpée */
+}	t_pack;
+
+/**
+ * @brief Destinataire d'une diffusion : sa liaison et son unité en cours
+ * 
+ * Chaque serveur avance à son rythme ; les acquittements sont rendus à
+ * leur destinataire d'après leur si_pid.
+ */
+typedef struct s_dest
+{
+	t_link			link;					/* PID, numéro, délai propres */
+	t_pack			pack;					/* Position dans le message */
+	unsigned int	units[BLOCK_WORDS + 1];	/* Unité en cours */
+	int				n;						/* Signaux de l'unité */
+	int				tries;					/* Envois de l'unité */
+	long			sent;					/* Instant du dernier envoi */
+	t_mt_dest		*out;					/* Résultat rendu à l'appelant */
+}	t_dest;
+
+/**
+ * @brief État de réception du serveur pour le client en cours
+ */
+typedef struct s_rx
+{
+	pid_t			client_pid;	/* Client en cours, 0 si aucun */
+	int				seq;		/* Numéro de la prochaine unité attendue */
+	int				i;			/* Bits reçus du caractère en cours */
+	unsigned char	c;			/* Caractère en reconstruction */
+	long			last_rx;	/* Dernier signal du client en cours */
+	pid_t			last_pid;	/* Dernier client servi */
+	int				last_seq;	/* Sa dernière unité, suivie de RT_DONE */
+	unsigned int	block[BLOCK_WORDS];	/* Mots du bloc en cours (-c) */
+	int				nwords;		/* Mots reçus pour ce bloc */
+}	t_rx;
+
+/**
+ * @brief Tables du CRC32C logiciel et disponibilité de SSE4.2
+ */
+typedef struct s_crc
+{
+	uint32_t	table[8][256];	/* Découpage par 8 octets */
+	int			hw;				/* Instruction crc32 utilisable */
+}	t_crc;
+
+/**
+ * @brief Message en cours de réception pour le rappel de mt_server_run
+ */
+typedef struct s_msg
+{
+	t_mt_on_message	hook;	/* Rappel, NULL : affichage au fil de l'eau */
+	char			*buf;	/* Octets reçus du message en cours */
+	size_t			len;	/* Octets occupés dans buf */
+	size_t			cap;	/* Taille allouée de buf */
+	int				failed;	/* Allocation échouée, message abandonné */
+}	t_msg;
+
+/**
+ * @brief Journal relu par mt-trace : événements valides, triés
+ */
+typedef struct s_trace_log
+{
+	t_trace_ev	*ev;	/* Événements, par instant croissant */
+	size_t		n;		/* Événements dans ev */
+	uint64_t	lost;	/* Écrasés par le tour de l'anneau */
+	uint64_t	torn;	/* En cours d'écriture pendant la lecture */
+	uint32_t	proto;	/* TRACE_MANDATORY ou TRACE_BONUS */
+}	t_trace_log;
+
+/**
+ * @brief Durées mesurées pour une étape, en nanosecondes
+ */
+typedef struct s_stage
+{
+	uint64_t	n;		/* Mesures */
+	uint64_t	sum;	/* Somme, pour la moyenne */
+	uint64_t	min;	/* Plus courte */
+	uint64_t	max;	/* Plus longue */
+}	t_stage;
+
+/**
+ * @brief Échanges d'un client avec un serveur, reconstitués par mt-trace
+ * 
+ * mark retient l'instant qui ouvre chaque étape (envoi, réception,
+ * acquittement émis, acquittement reçu) jusqu'à l'événement qui la
+ * ferme ; stage accumule les durées ainsi mesurées.
+ */
+typedef struct s_flow
+{
+	pid_t		client;					/* Émetteur des unités */
+	pid_t		server;					/* Destinataire */
+	uint64_t	recvs;					/* Signaux reçus par le serveur */
+	uint64_t	first;					/* Première réception */
+	uint64_t	last;					/* Dernière réception */
+	uint64_t	max_gap;				/* Plus longue attente entre deux */
+	uint64_t	mark[TRACE_STAGES];		/* Étapes ouvertes, 0 sinon */
+	t_stage		stage[TRACE_STAGES];	/* Durées par étape */
+}	t_flow;
+
+/**
+ * @brief Transport des signaux du protocole, choisi par mt_send
+ * 
+ * Le codage (ft_link_emit, ft_pack_unit) et le décodage
+ * (ft_server_signal) ne connaissent que ces trois opérations ; un
+ * nouveau transport n'a qu'à les fournir. Mêmes conventions que
+ * sigqueue() et sigtimedwait() : -1 et errno en cas d'échec, EAGAIN
+ * quand aucun acquittement n'arrivera avant l'échéance.
+ */
+typedef struct s_transport
+{
+	const char	*name;	/* "signal" ou "loopback" */
+	int			(*send_symbol)(pid_t pid, int sig, int value);
+	int			(*wait_ack)(const sigset_t *set, siginfo_t *info,
+			const struct timespec *ts);
+	int			(*send_ack)(pid_t pid, int sig, int value);
+}	t_transport;
+
+/**
+ * @brief Acquittements de la boucle locale, du décodeur vers le client
+ * 
+ * Le client n'a qu'une unité en vol : quelques emplacements suffisent,
+ * un acquittement de trop est perdu comme un signal qui n'arrive pas.
+ */
+typedef struct s_loopback
+{
+	int				sig[LOOPBACK_ACKS];		/* RT_ACK ou RT_DONE */
+	int				value[LOOPBACK_ACKS];	/* Numéro acquitté */
+	unsigned int	head;					/* Prochain à lire */
+	unsigned int	tail;					/* Prochain à écrire */
+	pid_t			self;					/* Client vu par le décodeur */
+	pid_t			server;					/* Destinataire des unités */
+}	t_loopback;
+
+/**
+ * @brief Message de référence de mt-codec et messages décodés conformes
+ */
+typedef struct s_codec
+{
+	const char	*src;	/* Message envoyé à chaque passe */
+	size_t		len;	/* Sa longueur */
+	int			good;	/* Messages rendus intacts par le décodeur */
+}	t_codec;
+
+typedef void	(*t_watch_cb)(int fd, void *arg);
+
+/**
+ * @brief Descripteur surveillé par la boucle d'événements
+ */
+typedef struct s_watch
+{
+	int			fd;		/* Descripteur enregistré dans epoll */
+	t_watch_cb	cb;		/* Appelé quand fd est prêt en lecture */
+	void		*arg;	/* Contexte transmis à cb */
+}	t_watch;
+
+/**
+ * @brief État de la boucle d'événements du serveur
+ */
+typedef struct s_loop
+{
+	int		epfd;					/* Instance epoll, 0 si pas encore créée */
+	int		count;					/* Emplacements utilisés dans watch */
+	t_watch	watch[LOOP_MAX_WATCH];	/* Index = epoll_event.data.u32 */
+}	t_loop;
 
 // Utils
+void	ft_out_init(void);
+void	ft_out_flush(void);
+void	ft_out_write(const char *buf, size_t len);
 void	ft_putchar(unsigned char c);
 void	ft_putnbr(int n);
 int		ft_atoi(const char *str);
+long	ft_now(void);
+void	ft_crc32c_init(void);
+uint32_t	ft_crc32c(const void *buf, size_t len);
 
 // Client
-void	ft_send_char(pid_t pid, unsigned char c);
+t_link	*ft_link(void);
+void	ft_link_rtt(t_link *l, long rtt);
+int		ft_link_emit(const t_link *l, const unsigned int *units, int n,
+			int mode);
+int		ft_link_send(pid_t pid, const unsigned int *units, int n, int mode);
+int		ft_send_char(pid_t pid, unsigned char c);
+void	ft_pack_init(t_pack *p, const char *buf, size_t len, int mode);
+int		ft_pack_unit(t_pack *p, unsigned int *units);
+int		ft_send_units(pid_t pid, t_pack *p);
+int		ft_fan_run(t_dest *d, size_t n, const sigset_t *set);
+int		ft_parse_pids(const char *arg, t_mt_dest **dests);
+int		ft_send_file(pid_t pid, const char *path);
+int		ft_stream_open(t_stream *st, const char *path);
+ssize_t	ft_stream_next(t_stream *st, const unsigned char **data);
+
+// Server
+void	ft_server_signal(int sig, pid_t pid, int value);
+void	ft_rx_ack(pid_t pid, int kind, int seq);
+void	ft_rx_char(unsigned char c, t_rx *rx);
+void	ft_receive_block(int sig, int value, t_rx *rx);
+int		ft_loop_watch(int fd, t_watch_cb cb, void *arg);
+int		ft_loop_run(void);
+t_msg	*ft_msg(void);
+int		ft_msg_push(unsigned char c);
+int		ft_msg_end(pid_t pid);
+
+// Transports
+t_transport	*ft_transport(void);
+int		ft_transport_use(int id);
+void	ft_loopback(t_transport *t);
+
+// Journal des signaux (MT_TRACE)
+t_trace	*ft_trace(void);
+void	ft_trace_init(void);
+void	ft_trace_rec(int what, pid_t peer, int value);
+
+// mt-codec
+t_codec	*ft_codec(void);
+long	ft_codec_encode(int mode, uint64_t *signals);
+long	ft_codec_loop(int mode);
+
+// mt-trace
+void	ft_putstr(const char *s);
+void	ft_putnbr_u64(uint64_t n, int width);
+int		ft_trace_load(const char *path, t_trace_log *log);
+void	ft_trace_timeline(const t_trace_log *log);
+void	ft_trace_flows(const t_trace_log *log, t_flow *flows);
+void	ft_trace_report(const t_trace_log *log);
+int		ft_trace_replay(const t_trace_log *log, int passes);
 
 #endif
@@ -0,0 +1,100 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   trace.h                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fdi-tria <fdi-tria@student.42lausanne.c    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 13:46:21 by fdi-tria          #+#    #+#             */
+/*   Updated: 2026/10/16 14:18:37 by fdi-tria         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef TRACE_H
+# define TRACE_H
+
+# include <stdint.h>
+# include <stdatomic.h>
+# include <sys/types.h>
+
+/*
+ * Journal binaire des signaux, activé par la variable d'environnement
+ * MT_TRACE=fichier : serveurs et clients, obligatoires comme bonus,
+ * y enregistrent chaque signal émis ou reçu. Le fichier est projeté en
+ * mémoire (mmap) et partagé : plusieurs processus peuvent écrire dans
+ * le même anneau, que mt-trace décode ensuite hors ligne.
+ *
+ * Capacité en événements, puissance de 2, modifiable à la compilation
+ * (-DTRACE_CAP=...) ; un fichier existant garde la sienne.
+ */
+# ifndef TRACE_CAP
+#  define TRACE_CAP 65536
+# endif
+# define TRACE_MAGIC "MTTRACE"
+# define TRACE_VERSION 1
+
+// Protocole des enregistreurs : les numéros RT_* diffèrent entre les deux
+# define TRACE_MANDATORY 0
+# define TRACE_BONUS 1
+
+/*
+ * Nature d'un événement, combinée au numéro du signal (TRACE_SEND | sig) :
+ * unité émise par un client, signal reçu par un serveur, acquittement
+ * émis par le serveur, acquittement reçu par le client.
+ */
+# define TRACE_SEND 0x100
+# define TRACE_RECV 0x200
+# define TRACE_ACK 0x300
+# define TRACE_ACKED 0x400
+# define TRACE_KIND 0xF00
+# define TRACE_SIG 0xFF
+
+/**
+ * @brief Événement du journal, 32 octets
+ *
+ * stamp vaut le rang d'écriture + 1 et n'est publié qu'une fois les
+ * autres champs écrits : un emplacement dont stamp ne correspond pas
+ * au rang attendu est en cours d'écriture ou déjà réécrit.
+ */
+typedef struct s_trace_ev
+{
+	_Atomic uint64_t	stamp;	/* Rang d'écriture + 1, 0 si invalide */
+	uint64_t			time;	/* CLOCK_MONOTONIC, en nanosecondes */
+	int32_t				self;	/* Processus qui a enregistré */
+	int32_t				peer;	/* Émetteur (si_pid) ou destinataire */
+	int32_t				value;	/* sival_int : numéro, mot, valeur */
+	uint16_t			what;	/* TRACE_SEND... | numéro du signal */
+	uint16_t			pad;
+}	t_trace_ev;
+
+/**
+ * @brief En-tête du fichier, 64 octets, suivi de cap événements
+ *
+ * head n'est jamais remis à zéro : l'événement de rang r occupe
+ * l'emplacement r % cap, et head - cap événements ont été écrasés
+ * quand l'anneau a fait le tour.
+ */
+typedef struct s_trace_hdr
+{
+	char				magic[8];	/* TRACE_MAGIC */
+	uint32_t			version;	/* TRACE_VERSION */
+	uint32_t			cap;		/* Emplacements, puissance de 2 */
+	_Atomic uint64_t	head;		/* Prochain rang à réserver */
+	uint32_t			proto;		/* TRACE_MANDATORY ou TRACE_BONUS */
+	uint32_t			rtmin;		/* SIGRTMIN de l'enregistreur */
+	uint8_t				pad[32];
+}	t_trace_hdr;
+
+/**
+ * @brief Journal ouvert par le processus
+ */
+typedef struct s_trace
+{
+	t_trace_hdr	*hdr;		/* Fichier projeté, NULL si inactif */
+	t_trace_ev	*ev;		/* Emplacements, après l'en-tête */
+	pid_t		self;		/* PID inscrit dans chaque événement */
+	int			tried;		/* MT_TRACE déjà consulté */
+	int			replay;		/* Rejeu (mt-trace) : rien n'est émis */
+}	t_trace;
+
+#endif
@@ -0,0 +1,121 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   client_batch_bonus.c                               :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fdi-tria <fdi-tria@student.42lausanne.c    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 06:31:08 by fdi-tria          #+#    #+#             */
+/*   Updated: 2026/10/16 06:44:20 by fdi-tria         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/* Définition des standards POSIX pour ssize_t et aio_read() */
+#define _POSIX_C_SOURCE 199309L
+#define _XOPEN_SOURCE 700
+#define _DEFAULT_SOURCE
+#include "bonus.h"
+
+/**
+ * @brief Transmet les lignes d'un morceau lu sur l'entrée standard
+ * @param pid     PID du serveur destinataire
+ * @param data    Morceau lu
+ * @param n       Taille du morceau
+ * @param verbose Active le mode debug
+ *
+ * Chaque ligne complète part dans une trame FRAME_F_NEXT, sans son
+ * '\n'. Une ligne coupée par la fin du morceau part en FRAME_F_MORE :
+ * le serveur la recolle à la suite du morceau suivant.
+ */
+static void	ft_send_lines(pid_t pid, const unsigned char *data, ssize_t n,
+				int verbose)
+{
+	ssize_t	start;
+	ssize_t	i;
+
+	start = 0;
+	i = 0;
+	while (i < n)
+	{
+		if (data[i] == '\n')
+		{
+			ft_send_frame_head_bonus(pid, i - start, FRAME_F_NEXT, verbose);
+			ft_send_bytes_bonus(pid, data + start, i - start, verbose);
+			start = i + 1;
+		}
+		i++;
+	}
+	if (start == n)
+		return ;
+	ft_send_frame_head_bonus(pid, n - start, FRAME_F_MORE, verbose);
+	ft_send_bytes_bonus(pid, data + start, n - start, verbose);
+}
+
+/**
+ * @brief Transmet les lignes de l'entrée standard comme un lot
+ * @param pid     PID du serveur destinataire
+ * @param verbose Active le mode debug
+ *
+ * Même lecture anticipée par morceaux que -f : la taille du lot n'a
+ * pas à être connue, une trame vide sans drapeau le clôt à la fin de
+ * l'entrée.
+ */
+static void	ft_send_stdin_batch(pid_t pid, int verbose)
+{
+	static t_stream		st;
+	const unsigned char	*data;
+	ssize_t				n;
+
+	if (!ft_stream_open(&st, "-"))
+	{
+		ft_print_colored("Erreur: Lecture de l'entrée impossible", COLOR_RED);
+		exit(1);
+	}
+	n = ft_stream_next(&st, &data);
+	while (n > 0)
+	{
+		ft_send_lines(pid, data, n, verbose);
+		n = ft_stream_next(&st, &data);
+	}
+	if (n < 0)
+	{
+		ft_print_colored("Erreur: Lecture de l'entrée interrompue", COLOR_RED);
+		exit(1);
+	}
+	ft_send_frame_head_bonus(pid, 0, 0, verbose);
+}
+
+/**
+ * @brief Transmet plusieurs messages sur une seule session (option -b)
+ * @param pid  PID du serveur destinataire
+ * @param opts Options du client : messages du lot et mode verbeux
+ *
+ * Un seul processus, une seule installation des gestionnaires et une
+ * seule session côté serveur pour tout le lot. Après CTL_FRAME, chaque
+ * message est une trame marquée FRAME_F_NEXT : le serveur l'affiche et
+ * garde la session ouverte. Le dernier message part sans drapeau, ce
+ * qui termine la session et déclenche la confirmation finale.
+ *
+ * Sans message sur la ligne de commande, les lignes de l'entrée
+ * standard forment le lot.
+ */
+void	ft_send_batch_bonus(pid_t pid, t_opts *opts)
+{
+	size_t	len;
+	int		i;
+
+	ft_print_colored("Début de la transmission (lot)...", COLOR_BLUE);
+	ft_send_char_bonus(pid, CTL_FRAME, opts->verbose);
+	if (!opts->batch_len)
+		ft_send_stdin_batch(pid, opts->verbose);
+	i = 0;
+	while (i < opts->batch_len)
+	{
+		len = ft_strlen_bonus(opts->batch[i]);
+		ft_send_frame_head_bonus(pid, len,
+			FRAME_F_NEXT * (i + 1 < opts->batch_len), opts->verbose);
+		ft_send_bytes_bonus(pid, opts->batch[i], len, opts->verbose);
+		i++;
+	}
+	ft_wait_done();
+}
@@ -6,7 +6,7 @@
 /*   By: fdi-tria <fdi-tria@student.42lausanne.c    +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/01/25 20:24:07 by fdi-tria          #+#    #+#             */
-/*   Updated: 2025/01/26 00:26:10 by fdi-tria         ###   ########.fr       */
+/*   Updated: 2026/10/16 16:29:50 by fdi-tria         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -17,11 +17,14 @@
 #include "bonus.h"
 
 /**
- * @brief Variable globale pour la synchronisation inter-processus
+ * @brief Drapeau levé par le gestionnaire à chaque SIGUSR1 ou SIGUSR2
  * 
- * Cette variable volatile de type sig_atomic_t assure une synchronisation
- * thread-safe entre le gestionnaire de signaux et le programme principal.
- * Son utilisation est considérée comme une bonne pratique dans ce contexte car :
+ * Seul le mode -m s'en sert encore : ft_ring_wait y attend le réveil
+ * du serveur quand l'anneau est plein. Les modes bit par bit, -r et -a
+ * retirent leurs acquittements avec sigtimedwait() (ft_retx_unit), et
+ * -w attend SIGRTMIN + RT_ACK de la même façon : le gestionnaire ne
+ * les voit pas. Le type choisi reste la bonne pratique pour partager
+ * une variable avec un gestionnaire de signaux :
  * 
  * 1. volatile : Empêche l'optimisation du compilateur qui pourrait cacher
  *              les modifications de la variable
@@ -33,32 +36,44 @@
  */
 volatile sig_atomic_t	g_signal_received;
 
+/**
+ * @brief Drapeau de fin de transmission, levé par la confirmation SIGUSR2
+ * 
+ * Le gestionnaire ne termine plus le programme : main() reprend la main
+ * pour afficher les statistiques d'envoi avant de quitter.
+ */
+volatile sig_atomic_t	g_done;
+
 /**
  * @brief Gestionnaire de signaux avancé pour le client
- * @param sig Numéro du signal reçu (SIGUSR1 ou SIGUSR2)
+ * @param sig     Numéro du signal reçu (SIGUSR1 ou SIGUSR2)
+ * @param info    Émetteur et valeur du signal, inscrits au journal
+ *                (MT_TRACE)
+ * @param context Contexte d'exécution (non utilisé)
  * 
  * Implémente un protocole de communication bidirectionnel :
  * 
  * SIGUSR2 : Signal de fin de transmission
  * - Indique que le serveur a reçu et traité l'intégralité du message
- * - Affiche un message de confirmation en vert
- * - Termine le programme avec succès (code 0)
+ * - Lève g_done ; il tient aussi lieu d'acquittement du dernier envoi,
+ *   que le serveur ne confirme pas par SIGUSR1
  * 
- * SIGUSR1 : Signal d'acquittement
- * - Confirme la réception d'un bit individuel
- * - Active le drapeau g_signal_received pour permettre l'envoi suivant
- * - Fait partie du mécanisme de contrôle de flux bit par bit
+ * SIGUSR1 : Réveil du mode -m
+ * - Le serveur a libéré de la place dans l'anneau partagé
+ * - Lève g_signal_received, attendu par ft_ring_wait
+ * - Les acquittements des bits, mots et symboles ne passent pas ici :
+ *   bloqués pendant l'attente, ils sont retirés par sigtimedwait()
  * 
  * @note Cette fonction est appelée de manière asynchrone et doit donc
  *       rester aussi simple et rapide que possible
  */
-static void	ft_sig_handler_bonus(int sig)
+static void	ft_sig_handler_bonus(int sig, siginfo_t *info, void *context)
 {
+	(void)context;
+	ft_trace_rec_bonus(TRACE_ACKED | sig, info->si_pid,
+		info->si_value.sival_int);
 	if (sig == SIGUSR2)
-	{
-		ft_print_colored("Message reçu avec succès!", COLOR_GREEN);
-		exit(0);
-	}
+		g_done = 1;
 	g_signal_received = 1;
 }
 
@@ -74,7 +89,7 @@ static void	ft_sig_handler_bonus(int sig)
  *    - Configuration des drapeaux de comportement
  * 
  * 2. Installation des gestionnaires pour :
- *    - SIGUSR1 : Acquittement de réception de bit
+ *    - SIGUSR1 : Réveil de l'anneau partagé (-m)
  *    - SIGUSR2 : Confirmation de fin de message
  * 
  * Cette approche moderne (sigaction vs signal()) offre :
@@ -86,9 +101,9 @@ static int	ft_init_signals(void)
 {
 	struct sigaction	sa;
 
-	sa.sa_handler = ft_sig_handler_bonus;
+	sa.sa_sigaction = ft_sig_handler_bonus;
 	sigemptyset(&sa.sa_mask);
-	sa.sa_flags = 0;
+	sa.sa_flags = SA_SIGINFO;
 	if (sigaction(SIGUSR1, &sa, NULL) == -1
 		|| sigaction(SIGUSR2, &sa, NULL) == -1)
 	{
@@ -98,41 +113,144 @@ static int	ft_init_signals(void)
 	return (1);
 }
 
+/**
+ * @brief Interprète une option de la ligne de commande
+ * @param argc Nombre d'arguments
+ * @param argv Tableau des arguments
+ * @param i    Index de l'option courante (avancé si l'option a une valeur)
+ * @param opts Options à compléter
+ * @return 1 si l'option est reconnue et valide, 0 sinon
+ * 
+ * Options disponibles :
+ * - -v   : mode verbeux, chaque envoi est affiché
+ * - -r   : transport temps réel, 16 bits par signal via sigqueue()
+ * - -w N : fenêtre glissante de N unités numérotées en vol (N > 0)
+ * - -m   : anneau en mémoire partagée, les signaux servent de sonnette
+ * - -z   : compression LZ77 du message avant l'envoi bit par bit
+ * - -H   : codage de Huffman canonique, bits de taille variable
+ * - -l   : trame à longueur préfixée, sans '\0' terminal
+ * - -a N : alphabet de N signaux temps réel (2, 4, 8, 16 ou 32), soit
+ *          log2(N) bits par signal ; le serveur peut réduire N
+ * - -j N : N voies parallèles (1 à LANE_MAX), un processus fils par
+ *          morceau du message
+ * - -J   : statistiques d'envoi finales en JSON sur une ligne
+ */
+static int	ft_parse_flag(int argc, char **argv, int *i, t_opts *opts)
+{
+	const char	*arg;
+
+	arg = argv[*i];
+	if (arg[0] != '-' || !arg[1] || arg[2])
+		return (0);
+	if (arg[1] == 'v')
+		opts->verbose = 1;
+	else if (arg[1] == 'r')
+		opts->rt = 1;
+	else if (arg[1] == 'm')
+		opts->shm = 1;
+	else if (arg[1] == 'z')
+		opts->lz = 1;
+	else if (arg[1] == 'H')
+		opts->huff = 1;
+	else if (arg[1] == 'l')
+		opts->frame = 1;
+	else if (arg[1] == 'J')
+		opts->json = 1;
+	else if (arg[1] == 'w' && *i + 1 < argc)
+	{
+		opts->window = ft_atoi_bonus(argv[++(*i)]);
+		return (opts->window > 0);
+	}
+	else if (arg[1] == 'a' && *i + 1 < argc)
+	{
+		opts->alphabet = ft_sym_bits(ft_atoi_bonus(argv[++(*i)]));
+		return (opts->alphabet > 0);
+	}
+	else if (arg[1] == 'j' && *i + 1 < argc)
+	{
+		opts->lanes = ft_atoi_bonus(argv[++(*i)]);
+		return (opts->lanes > 0 && opts->lanes <= LANE_MAX);
+	}
+	else
+		return (0);
+	return (1);
+}
+
 /**
  * @brief Analyse et valide les arguments du programme
  * @param argc    Nombre d'arguments reçus
  * @param argv    Tableau des arguments
- * @param verbose Pointeur vers le flag du mode verbeux
+ * @param opts    Options à remplir (mode verbeux, transport)
  * @param pid     Pointeur vers le PID du serveur destinataire
  * @return 1 si les arguments sont valides, 0 sinon
  * 
  * Validation complète des arguments avec les critères suivants :
  * 
- * Format attendu : ./client_bonus [pid] [message] [-v]
+ * Format attendu :
+ *   ./client_bonus [pid] [msg | -f path | -b [msg ...]] [-v] [-r]
+ *                  [-w N] [-m] [-z] [-H] [-l] [-a N] [-j N] [-J]
  * - [pid] : Identifiant du processus serveur (obligatoire)
  * - [message] : Texte à transmettre (obligatoire)
+ * - [-f path] : Fichier à transmettre à la place du message, "-" pour
+ *   l'entrée standard
+ * - [-b] : Lot de messages sur une seule session ; les options viennent
+ *   juste après -b, les arguments suivants sont les messages (à défaut,
+ *   les lignes de l'entrée standard)
  * - [-v] : Active le mode verbeux (optionnel)
+ * - [-r] : Active le transport temps réel (optionnel)
+ * - [-w N] : Active la fenêtre glissante de N unités (optionnel)
+ * - [-m] : Active l'anneau en mémoire partagée (optionnel)
+ * - [-z] : Compresse le message avant l'envoi (optionnel)
+ * - [-H] : Code le message par Huffman (optionnel)
+ * - [-l] : Envoie le message dans une trame (optionnel)
+ * - [-a N] : Envoie le message par symboles d'un alphabet de N
+ *   signaux (optionnel)
+ * - [-j N] : Envoie le message sur N voies parallèles (optionnel)
+ * - [-J] : Statistiques finales au format JSON (optionnel)
  * 
  * Règles de validation :
  * 1. Nombre d'arguments : minimum 3 (programme + pid + message)
- *                        maximum 4 (avec option -v)
  * 2. PID : Doit être un nombre positif non nul
- * 3. Option verbose : Doit être exactement "-v" si présente
+ * 3. Options : chacune doit être reconnue par ft_parse_flag
  * 
  * En cas d'erreur :
  * - Affiche un message d'usage en rouge
  * - Retourne 0 pour indiquer l'échec
  */
-static int	ft_check_args(int argc, char **argv, int *verbose, pid_t *pid)
+static int	ft_check_args(int argc, char **argv, t_opts *opts, pid_t *pid)
 {
-	if (argc < 3 || argc > 4)
+	int	i;
+
+	opts->verbose = 0;
+	opts->rt = 0;
+	opts->window = 0;
+	opts->shm = 0;
+	opts->json = 0;
+	opts->lz = 0;
+	opts->huff = 0;
+	opts->frame = 0;
+	opts->alphabet = 0;
+	opts->lanes = 0;
+	opts->file = NULL;
+	opts->batch = NULL;
+	i = 3;
+	if (argc >= 4 && argv[2][0] == '-' && argv[2][1] == 'f' && !argv[2][2])
+		opts->file = argv[3];
+	if (opts->file)
+		i = 4;
+	while (i < argc && ft_parse_flag(argc, argv, &i, opts))
+		i++;
+	if (argc >= 3 && argv[2][0] == '-' && argv[2][1] == 'b' && !argv[2][2])
 	{
-		ft_print_colored("Usage: ./client_bonus [pid] [msg] [-v]", COLOR_RED);
+		opts->batch = argv + i;
+		opts->batch_len = argc - i;
+		i = argc;
+	}
+	if (argc < 3 || i < argc)
+	{
+		ft_print_colored(USAGE_BONUS, COLOR_RED);
 		return (0);
 	}
-	*verbose = 0;
-	if (argc == 4 && argv[3][0] == '-' && argv[3][1] == 'v')
-		*verbose = 1;
 	*pid = ft_atoi_bonus(argv[1]);
 	if (*pid <= 0)
 	{
@@ -151,25 +269,55 @@ static int	ft_check_args(int argc, char **argv, int *verbose, pid_t *pid)
  * Séquence d'exécution du client :
  * 1. Validation des arguments de la ligne de commande
  * 2. Initialisation du système de gestion des signaux
- * 3. Transmission du message au serveur
+ * 3. Transmission au serveur : lot de messages sur une session (-b),
+ *    fichier par trames successives (-f), ou message en voies
+ *    parallèles (-j), par mémoire partagée (-m), fenêtre glissante
+ *    (-w), mots de 16 bits (-r), bit par bit après compression (-z),
+ *    codes de Huffman (-H), trame à longueur préfixée (-l), symboles
+ *    de plusieurs bits (-a) ou bit par bit
+ * 4. Après la confirmation du serveur, affichage des RTT mesurés
+ *    (min/moy/p50/p99/max) et du débit, en JSON avec -J
  * 
  * La fonction suit un modèle de gestion d'erreur strict :
  * - Vérifie chaque étape de l'initialisation
  * - Termine proprement en cas d'échec
  * - Utilise des codes de retour cohérents
- * 
- * @note Le programme ne termine pas normalement après l'envoi
- *       du message - il attend d'être interrompu par un signal
  */
 int	main(int argc, char **argv)
 {
 	pid_t	pid;
-	int		verbose;
+	t_opts	opts;
 
-	if (!ft_check_args(argc, argv, &verbose, &pid))
+	ft_out_init_bonus();
+	ft_trace_init_bonus();
+	if (!ft_check_args(argc, argv, &opts, &pid))
 		return (1);
 	if (!ft_init_signals())
 		return (1);
-	ft_send_message_bonus(pid, argv[2], verbose);
+	if (opts.batch)
+		ft_send_batch_bonus(pid, &opts);
+	else if (opts.file)
+		ft_send_file_bonus(pid, opts.file, opts.verbose);
+	else if (opts.lanes)
+		ft_send_lanes_bonus(pid, argv[2], &opts);
+	else if (opts.shm)
+		ft_send_message_shm_bonus(pid, argv[2], opts.verbose);
+	else if (opts.window)
+		ft_send_message_window_bonus(pid, argv[2], &opts);
+	else if (opts.rt)
+		ft_send_message_rt_bonus(pid, argv[2], opts.verbose);
+	else if (opts.lz)
+		ft_send_message_lz_bonus(pid, argv[2], opts.verbose);
+	else if (opts.huff)
+		ft_send_message_huff_bonus(pid, argv[2], opts.verbose);
+	else if (opts.alphabet)
+		ft_send_message_sym_bonus(pid, argv[2], &opts);
+	else if (opts.frame)
+		ft_send_frame_bonus(pid, argv[2], ft_strlen_bonus(argv[2]),
+			opts.verbose);
+	else
+		ft_send_message_bonus(pid, argv[2], opts.verbose);
+	ft_print_colored("Message reçu avec succès!", COLOR_GREEN);
+	ft_report_print(opts.json);
 	return (0);
 }
@@ -6,14 +6,12 @@
 /*   By: fdi-tria <fdi-tria@student.42lausanne.c    +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/01/25 20:30:32 by fdi-tria          #+#    #+#             */
-/*   Updated: 2025/01/26 00:27:53 by fdi-tria         ###   ########.fr       */
+/*   Updated: 2026/10/16 15:08:44 by fdi-tria         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #include "bonus.h"
 
-extern volatile sig_atomic_t	g_signal_received;
-
 /**
  * @brief Système de debug visuel pour l'envoi des bits
  * @param pid    PID du serveur destinataire
@@ -46,28 +44,21 @@ static void	ft_send_bit_verbose(pid_t pid, int bit_val)
  * - SIGUSR2 représente un bit à 1
  * - SIGUSR1 représente un bit à 0
  * 
- * La fonction intègre une gestion d'erreur robuste :
- * - Vérifie la réussite de chaque envoi de signal
- * - Termine proprement le programme en cas d'échec
- * - Affiche un message d'erreur explicite
+ * L'envoi, l'attente de l'acquittement et la reprise sont confiés à
+ * ft_retx_send (client_retx_bonus.c) : le bit part numéroté par
+ * sigqueue() et il est renvoyé s'il se perd en route.
  * 
- * @note En cas d'échec d'envoi, le programme se termine avec le code 1
+ * @note En cas d'échec d'envoi, ou si le serveur ne répond plus, le
+ *       programme se termine avec le code 1
  */
 static void	ft_send_bit_signal(pid_t pid, int bit_val)
 {
+	int	sig;
+
+	sig = SIGUSR1;
 	if (bit_val == 1)
-	{
-		if (kill(pid, SIGUSR2) == -1)
-		{
-			ft_print_colored("Erreur: Échec de l'envoi du signal", COLOR_RED);
-			exit(1);
-		}
-	}
-	else if (kill(pid, SIGUSR1) == -1)
-	{
-		ft_print_colored("Erreur: Échec de l'envoi du signal", COLOR_RED);
-		exit(1);
-	}
+		sig = SIGUSR2;
+	ft_retx_send(pid, sig);
 }
 
 /**
@@ -78,25 +69,27 @@ static void	ft_send_bit_signal(pid_t pid, int bit_val)
  * @param verbose Active le mode debug avec affichage détaillé
  * 
  * Cette fonction implémente le protocole complet de transmission d'un bit :
- * 1. Réinitialisation du flag de réception (g_signal_received)
- * 2. Affichage debug si le mode verbose est activé
- * 3. Envoi effectif du signal
- * 4. Attente active de l'acquittement du serveur
+ * 1. Affichage debug si le mode verbose est activé
+ * 2. Envoi effectif du signal, numéroté
+ * 3. Attente de l'acquittement du serveur, avec renvoi à l'échéance
+ * 4. Enregistrement de l'aller-retour dans l'histogramme des RTT
  * 
  * Le système d'acquittement garantit la fiabilité de la transmission :
  * - Chaque bit envoyé doit être confirmé par le serveur
- * - Le client attend en pause jusqu'à la réception de la confirmation
+ * - SIGUSR1 et SIGUSR2 ne sont pas mis en file : quand plusieurs
+ *   clients émettent en même temps, un bit peut se perdre côté
+ *   serveur. Sans acquittement avant le RTO, il est renvoyé ; le
+ *   serveur reconnaît le doublon à son numéro
  * 
- * @note Cette fonction est thread-safe grâce à l'utilisation de sig_atomic_t
+ * Les horodatages encadrent sigqueue() et le réveil : le RTT comprend
+ * le gestionnaire du serveur et les deux latences de réveil, mais pas
+ * l'affichage du mode verbeux.
  */
 void	ft_send_bit_bonus(pid_t pid, int bit_val, int verbose)
 {
-	g_signal_received = 0;
 	if (verbose)
 		ft_send_bit_verbose(pid, bit_val);
 	ft_send_bit_signal(pid, bit_val);
-	while (!g_signal_received)
-		pause();
 }
 
 /**
@@ -135,17 +128,17 @@ void	ft_send_char_bonus(pid_t pid, unsigned char c, int verbose)
  * 
  * Cette fonction orchestre le processus complet de transmission :
  * 1. Notification du début de transmission
- * 2. Envoi séquentiel de chaque caractère
- * 3. Transmission du caractère nul terminal ('\0')
- * 4. Attente de la confirmation finale
+ * 2. Échappement (CTL_ESC) d'un premier octet réservé aux octets de
+ *    contrôle, que le serveur prendrait sinon pour un mode
+ * 3. Envoi séquentiel de chaque caractère
+ * 4. Transmission du caractère nul terminal ('\0')
+ * 5. Attente de la confirmation finale (ft_wait_done)
  * 
  * Particularités importantes :
  * - Le '\0' terminal est explicitement transmis pour marquer la fin
- * - La fonction attend indéfiniment la confirmation finale du serveur
+ * - La fonction attend la confirmation finale du serveur avant de
+ *   rendre la main à main(), qui affiche les statistiques d'envoi
  * - L'affichage est coloré pour une meilleure lisibilité
- * 
- * @note La fonction ne retourne jamais normalement, elle attend
- *       une interruption par signal pour terminer
  */
 void	ft_send_message_bonus(pid_t pid, const char *message, int verbose)
 {
@@ -153,12 +146,13 @@ void	ft_send_message_bonus(pid_t pid, const char *message, int verbose)
 
 	i = 0;
 	ft_print_colored("Début de la transmission...", COLOR_BLUE);
+	if ((unsigned char)message[0] >= CTL_SYM)
+		ft_send_char_bonus(pid, CTL_ESC, verbose);
 	while (message[i])
 	{
 		ft_send_char_bonus(pid, message[i], verbose);
 		i++;
 	}
 	ft_send_char_bonus(pid, '\0', verbose);
-	while (1)
-		pause();
+	ft_wait_done();
 }
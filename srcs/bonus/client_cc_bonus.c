@@ -0,0 +1,172 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   client_cc_bonus.c                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fdi-tria <fdi-tria@student.42lausanne.c    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 09:56:12 by fdi-tria          #+#    #+#             */
+/*   Updated: 2026/10/16 16:19:02 by fdi-tria         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "bonus.h"
+
+/**
+ * @brief Démarre le contrôleur avec une seule unité en vol
+ * @param cc  Contrôleur à initialiser
+ * @param cap Plafond de la fenêtre (-w N borné par le système)
+ * 
+ * Comme TCP, la fenêtre part de 1 et double à chaque aller-retour tant
+ * qu'elle reste sous ssthresh (démarrage lent) ; ssthresh vaut d'abord
+ * le plafond, donc la première baisse seule fixe le régime AIMD.
+ */
+void	ft_cc_init(t_cc *cc, size_t cap)
+{
+	cc->cwnd = 1;
+	cc->cwnd_max = 1;
+	cc->cap = cap;
+	cc->ssthresh = cap;
+	cc->acc = 0;
+	cc->base = 0;
+	cc->recover = 0;
+	cc->srtt = 0;
+	cc->rttvar = 0;
+	cc->min_rtt = 0;
+	cc->rto = CC_RTO_INIT_US * 1000L;
+}
+
+/**
+ * @brief Intègre une mesure de RTT (Jacobson/Karels, RFC 6298)
+ * @param cc  Contrôleur
+ * @param rtt Aller-retour mesuré en nanosecondes
+ * 
+ * Même estimateur que le lien du client obligatoire : rttvar suit
+ * l'écart moyen au quart, srtt la moyenne au huitième, et le RTO vaut
+ * srtt + 4 * rttvar, borné. Le minimum retenu est celui de srtt : un
+ * acquittement déjà en file au moment de l'envoi donne un RTT brut
+ * sans rapport avec la charge. Sert aussi à la reprise du mode bit par
+ * bit (client_retx_bonus.c), qui n'a pas de fenêtre.
+ */
+void	ft_cc_rtt(t_cc *cc, long rtt)
+{
+	long	err;
+
+	if (!cc->srtt)
+	{
+		cc->srtt = rtt;
+		cc->rttvar = rtt / 2;
+	}
+	else
+	{
+		err = cc->srtt - rtt;
+		if (err < 0)
+			err = -err;
+		cc->rttvar += (err - cc->rttvar) / 4;
+		cc->srtt += (rtt - cc->srtt) / 8;
+	}
+	if (!cc->min_rtt || cc->srtt < cc->min_rtt)
+		cc->min_rtt = cc->srtt;
+	cc->rto = cc->srtt + 4 * cc->rttvar;
+	if (cc->rto < CC_RTO_MIN_US * 1000L)
+		cc->rto = CC_RTO_MIN_US * 1000L;
+	if (cc->rto > CC_RTO_MAX_US * 1000L)
+		cc->rto = CC_RTO_MAX_US * 1000L;
+}
+
+/**
+ * @brief Affiche la fenêtre courante et le RTT lissé en mode verbeux
+ * @param cc      Contrôleur
+ * @param verbose Mode verbeux du client
+ */
+static void	ft_cc_show(t_cc *cc, int verbose)
+{
+	if (!verbose)
+		return ;
+	ft_putstr_bonus(COLOR_YELLOW "Fenêtre: ");
+	ft_putnbr_bonus((int)cc->cwnd);
+	ft_putstr_bonus(" unités, RTT lissé: ");
+	ft_putnbr_bonus((int)(cc->srtt / 1000));
+	ft_putstr_bonus(" µs\n" COLOR_RESET);
+}
+
+/**
+ * @brief Fait réagir la fenêtre à un acquittement qui la fait glisser
+ * @param cc      Contrôleur
+ * @param base    Nouvelle plus ancienne unité non acquittée
+ * @param rtt     RTT de la dernière unité acquittée, en nanosecondes, ou
+ *                -1 si elle a été renvoyée (mesure ambiguë, écartée)
+ * @param verbose Mode verbeux du client
+ * 
+ * Un RTT lissé qui dépasse son minimum de plus de CC_QUEUE_US signale
+ * que la file du serveur s'allonge : la fenêtre est réduite avant que
+ * RLIMIT_SIGPENDING ne soit atteint. Le seuil est un délai absolu et
+ * non un multiple du minimum : quelques microsecondes d'écart ne
+ * disent rien de la charge, et une file plus longue amortit les
+ * réveils du serveur. Sinon elle croît d'une unité par
+ * unité acquittée en démarrage lent, puis d'une unité par fenêtre
+ * entière acquittée (croissance additive). Une seule baisse par
+ * fenêtre : les acquittements d'unités parties avant la baisse
+ * (base < recover) portent encore l'ancienne file d'attente.
+ */
+void	ft_cc_ack(t_cc *cc, size_t base, long rtt, int verbose)
+{
+	size_t	acked;
+
+	acked = base - cc->base;
+	cc->base = base;
+	if (rtt >= 0)
+		ft_cc_rtt(cc, rtt);
+	if (cc->srtt - cc->min_rtt > CC_QUEUE_US * 1000L && base >= cc->recover
+		&& cc->cwnd > 1)
+	{
+		ft_cc_cut(cc, base + cc->cwnd, 0, verbose);
+		return ;
+	}
+	if (cc->cwnd < cc->ssthresh)
+		cc->cwnd += acked;
+	else
+	{
+		cc->acc += acked;
+		if (cc->acc >= cc->cwnd)
+		{
+			cc->acc -= cc->cwnd;
+			cc->cwnd++;
+		}
+	}
+	if (cc->cwnd > cc->cap)
+		cc->cwnd = cc->cap;
+	if (cc->cwnd > cc->cwnd_max)
+		cc->cwnd_max = cc->cwnd;
+}
+
+/**
+ * @brief Réduit la fenêtre (diminution multiplicative)
+ * @param cc      Contrôleur
+ * @param next    Prochaine unité à envoyer : fin de la fenêtre actuelle
+ * @param timeout 1 si aucun acquittement n'est arrivé avant le RTO
+ * @param verbose Mode verbeux du client
+ * 
+ * La fenêtre est divisée par deux. Un délai dépassé est plus grave
+ * qu'un RTT en hausse : la fenêtre repart de 1 en démarrage lent et le
+ * RTO double, comme après une perte en TCP.
+ */
+void	ft_cc_cut(t_cc *cc, size_t next, int timeout, int verbose)
+{
+	if (!timeout && next < cc->recover)
+		return ;
+	cc->ssthresh = cc->cwnd / 2;
+	if (cc->ssthresh < 1)
+		cc->ssthresh = 1;
+	cc->cwnd = cc->ssthresh;
+	if (timeout)
+	{
+		cc->cwnd = 1;
+		cc->rto *= 2;
+		if (cc->rto > CC_RTO_MAX_US * 1000L)
+			cc->rto = CC_RTO_MAX_US * 1000L;
+	}
+	cc->acc = 0;
+	cc->recover = next;
+	ft_cc_show(cc, verbose);
+}
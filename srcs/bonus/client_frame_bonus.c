@@ -0,0 +1,80 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   client_frame_bonus.c                               :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fdi-tria <fdi-tria@student.42lausanne.c    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 05:55:31 by fdi-tria          #+#    #+#             */
+/*   Updated: 2026/10/16 06:44:20 by fdi-tria         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "bonus.h"
+
+/**
+ * @brief Transmet l'en-tête d'une trame : taille en varint et drapeaux
+ * @param pid     PID du serveur destinataire
+ * @param len     Taille du contenu qui suit
+ * @param flags   Drapeaux de la trame (FRAME_F_MORE)
+ * @param verbose Active le mode debug
+ *
+ * 7 bits par octet, poids faible d'abord ; le bit 7 annonce un octet
+ * supplémentaire. Un message de moins de 128 octets ne coûte qu'un
+ * octet de taille, soit 8 signaux, autant que l'ancien '\0' terminal.
+ */
+void	ft_send_frame_head_bonus(pid_t pid, size_t len, int flags, int verbose)
+{
+	while (len >= 0x80)
+	{
+		ft_send_char_bonus(pid, (len & 0x7F) | 0x80, verbose);
+		len >>= 7;
+	}
+	ft_send_char_bonus(pid, len, verbose);
+	ft_send_char_bonus(pid, flags, verbose);
+}
+
+/**
+ * @brief Transmet le contenu d'une trame, octet par octet
+ * @param pid     PID du serveur destinataire
+ * @param data    Octets à transmettre
+ * @param len     Nombre d'octets
+ * @param verbose Active le mode debug
+ */
+void	ft_send_bytes_bonus(pid_t pid, const void *data, size_t len,
+			int verbose)
+{
+	const unsigned char	*bytes;
+	size_t				i;
+
+	bytes = data;
+	i = 0;
+	while (i < len)
+		ft_send_char_bonus(pid, bytes[i++], verbose);
+}
+
+/**
+ * @brief Transmet un contenu quelconque dans une trame (option -l)
+ * @param pid     PID du serveur destinataire
+ * @param buf     Octets à transmettre, '\0' compris
+ * @param len     Nombre d'octets de buf
+ * @param verbose Active le mode debug
+ *
+ * CTL_FRAME, la taille en varint et l'octet de drapeaux précèdent le
+ * contenu : le serveur réserve son tampon avant le premier octet utile
+ * et sait où s'arrête la trame sans chercher de terminateur. Au-delà de
+ * FRAME_MAX_LEN, le serveur refuserait la trame : le client s'arrête.
+ */
+void	ft_send_frame_bonus(pid_t pid, const void *buf, size_t len, int verbose)
+{
+	if (len > FRAME_MAX_LEN)
+	{
+		ft_print_colored("Erreur: Trame trop longue", COLOR_RED);
+		exit(1);
+	}
+	ft_print_colored("Début de la transmission (trame)...", COLOR_BLUE);
+	ft_send_char_bonus(pid, CTL_FRAME, verbose);
+	ft_send_frame_head_bonus(pid, len, 0, verbose);
+	ft_send_bytes_bonus(pid, buf, len, verbose);
+	ft_wait_done();
+}
@@ -0,0 +1,139 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   client_hist_bonus.c                                :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fdi-tria <fdi-tria@student.42lausanne.c    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 05:10:12 by fdi-tria          #+#    #+#             */
+/*   Updated: 2026/10/16 10:14:05 by fdi-tria         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "bonus.h"
+
+/**
+ * @brief Accès à l'histogramme des RTT du client
+ * @return Histogramme statique, remis à zéro au lancement
+ */
+t_hist	*ft_hist(void)
+{
+	static t_hist	hist;
+
+	return (&hist);
+}
+
+/**
+ * @brief Vide l'histogramme des RTT
+ */
+void	ft_hist_reset(void)
+{
+	t_hist	*h;
+	int		i;
+
+	h = ft_hist();
+	i = 0;
+	while (i < HIST_BUCKETS)
+		h->count[i++] = 0;
+	h->samples = 0;
+	h->min = 0;
+	h->max = 0;
+	h->sum = 0;
+	h->bits = 0;
+	h->cwnd = 0;
+	h->cwnd_max = 0;
+	h->srtt = 0;
+}
+
+/**
+ * @brief Classe d'un RTT dans l'histogramme
+ * @param v RTT en nanosecondes
+ * @return Index entre 0 et HIST_BUCKETS - 1
+ *
+ * En dessous de 2^HIST_SUB_BITS, chaque valeur a sa propre classe.
+ * Au-delà, la position du bit de poids fort choisit la ligne et les
+ * HIST_SUB_BITS bits suivants la sous-classe : la largeur d'une classe
+ * reste proportionnelle à sa valeur, comme dans HdrHistogram.
+ */
+static int	ft_hist_bucket(uint64_t v)
+{
+	int	shift;
+
+	if (v < (1u << HIST_SUB_BITS))
+		return ((int)v);
+	shift = 63 - __builtin_clzll(v) - HIST_SUB_BITS;
+	return (((shift + 1) << HIST_SUB_BITS)
+		+ (int)((v >> shift) - (1u << HIST_SUB_BITS)));
+}
+
+/**
+ * @brief Plus grande valeur appartenant à une classe
+ * @param idx Index de la classe
+ * @return Borne haute de la classe en nanosecondes
+ */
+static uint64_t	ft_hist_upper(int idx)
+{
+	int			shift;
+	uint64_t	mant;
+
+	if (idx < (1 << HIST_SUB_BITS))
+		return (idx);
+	shift = (idx >> HIST_SUB_BITS) - 1;
+	mant = (idx & ((1 << HIST_SUB_BITS) - 1)) + (1u << HIST_SUB_BITS);
+	return (((mant + 1) << shift) - 1);
+}
+
+/**
+ * @brief Enregistre un aller-retour signal / acquittement
+ * @param sent  Horodatage de l'envoi (ft_now_ns)
+ * @param acked Horodatage de la réception de l'acquittement
+ * @param bits  Bits de données confirmés par cet acquittement
+ */
+void	ft_hist_record(uint64_t sent, uint64_t acked, int bits)
+{
+	t_hist		*h;
+	uint64_t	rtt;
+
+	h = ft_hist();
+	rtt = acked - sent;
+	if (!h->samples || rtt < h->min)
+		h->min = rtt;
+	if (rtt > h->max)
+		h->max = rtt;
+	if (!h->samples)
+		h->first = sent;
+	h->last = acked;
+	h->sum += rtt;
+	h->bits += bits;
+	h->samples++;
+	h->count[ft_hist_bucket(rtt)]++;
+}
+
+/**
+ * @brief Percentile des RTT enregistrés
+ * @param h        Histogramme à interroger
+ * @param permille Rang demandé en millièmes (500 pour p50, 990 pour p99)
+ * @return Borne haute de la classe atteinte, plafonnée au maximum observé
+ */
+uint64_t	ft_hist_percentile(t_hist *h, int permille)
+{
+	uint64_t	rank;
+	uint64_t	seen;
+	int			idx;
+
+	rank = (h->samples * permille + 999) / 1000;
+	if (!rank)
+		rank = 1;
+	seen = 0;
+	idx = 0;
+	while (idx < HIST_BUCKETS - 1)
+	{
+		seen += h->count[idx];
+		if (seen >= rank)
+			break ;
+		idx++;
+	}
+	if (ft_hist_upper(idx) > h->max)
+		return (h->max);
+	return (ft_hist_upper(idx));
+}
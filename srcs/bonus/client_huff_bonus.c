@@ -0,0 +1,208 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   client_huff_bonus.c                                :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fdi-tria <fdi-tria@student.42lausanne.c    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 05:36:52 by fdi-tria          #+#    #+#             */
+/*   Updated: 2026/10/16 05:47:10 by fdi-tria         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "bonus.h"
+
+/**
+ * @brief Nœud libre de plus petit poids de l'arbre en construction
+ * @param weight Poids des nœuds, 0 pour un symbole absent
+ * @param parent Parent de chaque nœud, -1 tant qu'il n'est pas rattaché
+ * @param nodes  Nombre de nœuds existants
+ * @param skip   Nœud à ignorer (le premier minimum déjà choisi), ou -1
+ * @return Index du nœud, ou -1 s'il n'en reste aucun
+ *
+ * Recherche linéaire : au plus 2 * HUF_SYMBOLS nœuds, une fois par
+ * message, le coût est sans commune mesure avec celui d'un signal.
+ */
+static int	ft_huff_min(size_t *weight, int *parent, int nodes, int skip)
+{
+	int	best;
+	int	i;
+
+	best = -1;
+	i = 0;
+	while (i < nodes)
+	{
+		if (weight[i] && parent[i] == -1 && i != skip
+			&& (best == -1 || weight[i] < weight[best]))
+			best = i;
+		i++;
+	}
+	return (best);
+}
+
+/**
+ * @brief Calcule la longueur du code de chaque symbole
+ * @param h État du codeur, freq déjà rempli
+ * @return La plus grande longueur obtenue
+ *
+ * Arbre de Huffman classique : les deux nœuds libres les plus légers
+ * sont réunis jusqu'à ce qu'il n'en reste qu'un. La profondeur d'une
+ * feuille est la longueur de son code ; un symbole seul reçoit 1 bit.
+ */
+static int	ft_huff_lengths(t_huffenc *h)
+{
+	size_t	weight[2 * HUF_SYMBOLS];
+	int		parent[2 * HUF_SYMBOLS];
+	int		nodes;
+	int		a;
+	int		b;
+
+	nodes = 0;
+	while (nodes < HUF_SYMBOLS)
+	{
+		weight[nodes] = h->freq[nodes];
+		parent[nodes++] = -1;
+	}
+	a = ft_huff_min(weight, parent, nodes, -1);
+	b = ft_huff_min(weight, parent, nodes, a);
+	while (b != -1)
+	{
+		weight[nodes] = weight[a] + weight[b];
+		parent[nodes] = -1;
+		parent[a] = nodes;
+		parent[b] = nodes++;
+		a = ft_huff_min(weight, parent, nodes, -1);
+		b = ft_huff_min(weight, parent, nodes, a);
+	}
+	b = 0;
+	a = -1;
+	while (++a < HUF_SYMBOLS)
+	{
+		h->len[a] = (h->freq[a] != 0);
+		nodes = a;
+		while (h->len[a] && parent[nodes] != -1 && parent[parent[nodes]] != -1)
+		{
+			h->len[a]++;
+			nodes = parent[nodes];
+		}
+		if (h->len[a] > b)
+			b = h->len[a];
+	}
+	return (b);
+}
+
+/**
+ * @brief Construit le code canonique d'un message
+ * @param h       État du codeur à remplir
+ * @param message Texte à coder, '\0' terminal compris
+ *
+ * Si un code dépasse HUF_MAX_LEN bits (4 bits dans l'en-tête), les
+ * fréquences sont divisées par deux, sans descendre sous 1, et l'arbre
+ * est reconstruit. Les symboles sont ensuite rangés par longueur puis
+ * par valeur et numérotés consécutivement : c'est l'ordre que le
+ * serveur attend dans l'en-tête pour décoder sans construire de table.
+ */
+static void	ft_huff_build(t_huffenc *h, const unsigned char *message)
+{
+	int				i;
+	int				len;
+	unsigned int	code;
+
+	i = 0;
+	while (i < HUF_SYMBOLS)
+		h->freq[i++] = 0;
+	i = 0;
+	while (message[i])
+		h->freq[message[i++]]++;
+	h->freq[0] = 1;
+	while (ft_huff_lengths(h) > HUF_MAX_LEN)
+	{
+		i = 0;
+		while (i < HUF_SYMBOLS)
+		{
+			if (h->freq[i])
+				h->freq[i] = (h->freq[i] >> 1) | 1;
+			i++;
+		}
+	}
+	h->n = 0;
+	code = 0;
+	len = 0;
+	while (++len <= HUF_MAX_LEN)
+	{
+		i = -1;
+		while (++i < HUF_SYMBOLS)
+		{
+			if (h->len[i] != len)
+				continue ;
+			h->order[h->n++] = i;
+			h->code[i] = code++;
+		}
+		code <<= 1;
+	}
+}
+
+/**
+ * @brief Envoie les nbits de poids faible d'une valeur, poids fort d'abord
+ * @param pid     PID du serveur destinataire
+ * @param value   Valeur à transmettre
+ * @param nbits   Nombre de bits
+ * @param verbose Active le mode debug
+ */
+static void	ft_huff_put(pid_t pid, unsigned int value, int nbits, int verbose)
+{
+	while (nbits--)
+		ft_send_bit_bonus(pid, (value >> nbits) & 1, verbose);
+}
+
+/**
+ * @brief Transmet un message codé par Huffman canonique (option -H)
+ * @param pid     PID du serveur destinataire
+ * @param message Chaîne à transmettre
+ * @param verbose Active le mode debug
+ *
+ * Le canal transporte déjà des bits isolés : un caractère fréquent
+ * codé sur 3 ou 4 bits coûte autant de signaux, au lieu de 8. Après
+ * l'octet CTL_HUF, l'en-tête annonce les symboles présents et la
+ * longueur de leur code (HUF_ENTRY_BITS chacun), puis le texte suit,
+ * terminé par le code de '\0'.
+ *
+ * Si l'en-tête et le texte codé ne coûtent pas moins de signaux que
+ * l'envoi en clair, le message part par ft_send_message_bonus.
+ */
+void	ft_send_message_huff_bonus(pid_t pid, const char *message, int verbose)
+{
+	t_huffenc	h;
+	size_t		bits;
+	size_t		i;
+
+	ft_huff_build(&h, (const unsigned char *)message);
+	bits = 16 + h.n * HUF_ENTRY_BITS + h.len[0];
+	i = 0;
+	while (message[i])
+		bits += h.len[(unsigned char)message[i++]];
+	if (bits >= 8 * (i + 1))
+	{
+		ft_send_message_bonus(pid, message, verbose);
+		return ;
+	}
+	ft_print_colored("Début de la transmission (Huffman)...", COLOR_BLUE);
+	ft_send_char_bonus(pid, CTL_HUF, verbose);
+	ft_huff_put(pid, h.n - 1, 8, verbose);
+	i = 0;
+	while (i < (size_t)h.n)
+	{
+		ft_huff_put(pid, (h.order[i] << 4) | h.len[h.order[i]],
+			HUF_ENTRY_BITS, verbose);
+		i++;
+	}
+	i = 0;
+	while (message[i])
+	{
+		ft_huff_put(pid, h.code[(unsigned char)message[i]],
+			h.len[(unsigned char)message[i]], verbose);
+		i++;
+	}
+	ft_huff_put(pid, h.code[0], h.len[0], verbose);
+	ft_wait_done();
+}
@@ -0,0 +1,200 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   client_lane_bonus.c                                :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fdi-tria <fdi-tria@student.42lausanne.c    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 08:53:06 by fdi-tria          #+#    #+#             */
+/*   Updated: 2026/10/16 15:31:12 by fdi-tria         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/* Définition des standards POSIX pour mmap() et MAP_ANONYMOUS */
+#define _POSIX_C_SOURCE 199309L
+#define _XOPEN_SOURCE 700
+#define _DEFAULT_SOURCE
+#include "bonus.h"
+#include <sys/mman.h>
+#include <sys/wait.h>
+
+/**
+ * @brief Ajoute l'histogramme d'une voie à celui du client
+ * @param dst Histogramme du client parent
+ * @param src Histogramme rapporté par une voie
+ *
+ * La durée retenue va du premier envoi de la première voie au dernier
+ * acquittement de la dernière : le débit rapporté est celui du message
+ * entier, et non la somme des débits des voies.
+ */
+static void	ft_hist_merge(t_hist *dst, const t_hist *src)
+{
+	int	i;
+
+	if (!src->samples)
+		return ;
+	i = -1;
+	while (++i < HIST_BUCKETS)
+		dst->count[i] += src->count[i];
+	if (!dst->samples || src->min < dst->min)
+		dst->min = src->min;
+	if (src->max > dst->max)
+		dst->max = src->max;
+	if (!dst->samples || src->first < dst->first)
+		dst->first = src->first;
+	if (src->last > dst->last)
+		dst->last = src->last;
+	dst->samples += src->samples;
+	dst->sum += src->sum;
+	dst->bits += src->bits;
+}
+
+/**
+ * @brief Corps d'un processus de voie : envoie un morceau puis se termine
+ * @param pid   PID du serveur destinataire
+ * @param head  En-tête de la voie, PID du parent déjà renseigné
+ * @param chunk Morceau du message attribué à la voie
+ * @param hist  Emplacement partagé où rapporter les RTT de la voie
+ *
+ * La voie a son propre PID, donc sa propre session côté serveur, et
+ * elle est acquittée en même temps que ses sœurs. Elle parle par mots
+ * de 16 bits (SIGRTMIN + RT_WORD) : SIGUSR1 et SIGUSR2 envoyés par
+ * plusieurs voies à la fois seraient fusionnés par le noyau tant que le
+ * serveur les masque, alors que les signaux temps réel sont mis en
+ * file. CTL_LANE, l'en-tête et le morceau sont copiés bout à bout pour
+ * ne compléter que le dernier mot. Sa confirmation SIGUSR2 ne porte
+ * que sur son morceau.
+ */
+static void	ft_lane_run(pid_t pid, unsigned char *head, const char *chunk,
+				t_hist *hist)
+{
+	unsigned char	*buf;
+	size_t			len;
+	size_t			i;
+
+	len = (size_t)head[6] << 24 | head[7] << 16 | head[8] << 8 | head[9];
+	buf = malloc(len + LANE_HEADER + 1);
+	if (!buf)
+	{
+		ft_print_colored("Erreur: Mémoire insuffisante", COLOR_RED);
+		ft_out_flush_bonus();
+		_exit(1);
+	}
+	buf[0] = CTL_LANE;
+	i = 0;
+	while (i < LANE_HEADER)
+	{
+		buf[i + 1] = head[i];
+		i++;
+	}
+	i = 0;
+	while (i < len)
+	{
+		buf[i + LANE_HEADER + 1] = chunk[i];
+		i++;
+	}
+	ft_hist_reset();
+	ft_trace_init_bonus();
+	ft_send_words_bonus(pid, buf, len + LANE_HEADER + 1, head[LANE_HEADER]);
+	free(buf);
+	ft_wait_done();
+	*hist = *ft_hist();
+	ft_out_flush_bonus();
+	_exit(0);
+}
+
+/**
+ * @brief Crée le processus d'une voie
+ * @param pid  PID du serveur destinataire
+ * @param msg  Message complet
+ * @param lane Numéro de la voie, nombre de voies et mode verbeux
+ * @param hist Tableau partagé des histogrammes, un par voie
+ *
+ * La voie i reçoit les octets [len * i / n, len * (i + 1) / n) : les
+ * morceaux sont disjoints, couvrent tout le message et diffèrent d'au
+ * plus un octet.
+ */
+static void	ft_lane_fork(pid_t pid, const char *msg, const int lane[3],
+				t_hist *hist)
+{
+	unsigned char	head[LANE_HEADER + 1];
+	size_t			total;
+	size_t			start;
+	size_t			len;
+	pid_t			owner;
+
+	total = ft_strlen_bonus(msg);
+	start = total * lane[0] / lane[1];
+	len = total * (lane[0] + 1) / lane[1] - start;
+	owner = getpid();
+	head[0] = owner >> 24;
+	head[1] = owner >> 16;
+	head[2] = owner >> 8;
+	head[3] = owner;
+	head[4] = lane[0];
+	head[5] = lane[1];
+	head[6] = len >> 24;
+	head[7] = len >> 16;
+	head[8] = len >> 8;
+	head[9] = len;
+	head[LANE_HEADER] = lane[2];
+	owner = fork();
+	if (owner == -1)
+	{
+		ft_print_colored("Erreur: Création de la voie échouée", COLOR_RED);
+		exit(1);
+	}
+	if (owner == 0)
+		ft_lane_run(pid, head, msg + start, &hist[lane[0]]);
+}
+
+/**
+ * @brief Transmet un message sur plusieurs voies parallèles (option -j N)
+ * @param pid     PID du serveur destinataire
+ * @param message Chaîne à transmettre
+ * @param opts    Options du client (nombre de voies, mode verbeux)
+ *
+ * Un aller-retour signal/acquittement par bit laisse le serveur oisif
+ * la plupart du temps : N processus fils envoient chacun un morceau du
+ * message en même temps, et le serveur remet les morceaux dans l'ordre
+ * des voies avant d'afficher le message. Le parent n'envoie rien ; il
+ * attend la confirmation SIGUSR2 du message complet, récupère ses fils
+ * puis fusionne leurs histogrammes de RTT, rapportés par une zone
+ * mmap() partagée.
+ *
+ * Le nombre de voies est ramené à la taille du message, sans descendre
+ * sous une voie : un message vide part sur une voie de taille nulle.
+ */
+void	ft_send_lanes_bonus(pid_t pid, const char *message, t_opts *opts)
+{
+	t_hist	*hist;
+	int		lane[3];
+
+	lane[1] = opts->lanes;
+	if ((size_t)lane[1] > ft_strlen_bonus(message))
+		lane[1] = ft_strlen_bonus(message);
+	if (lane[1] < 1)
+		lane[1] = 1;
+	lane[2] = opts->verbose;
+	hist = mmap(NULL, sizeof(t_hist) * lane[1], PROT_READ | PROT_WRITE,
+			MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+	if (hist == MAP_FAILED)
+	{
+		ft_print_colored("Erreur: Mémoire partagée indisponible", COLOR_RED);
+		exit(1);
+	}
+	ft_print_colored("Début de la transmission (voies parallèles)...",
+		COLOR_BLUE);
+	ft_out_flush_bonus();
+	lane[0] = -1;
+	while (++lane[0] < lane[1])
+		ft_lane_fork(pid, message, lane, hist);
+	ft_wait_done();
+	while (wait(NULL) > 0)
+		continue ;
+	ft_hist_reset();
+	lane[0] = -1;
+	while (++lane[0] < lane[1])
+		ft_hist_merge(ft_hist(), &hist[lane[0]]);
+	munmap(hist, sizeof(t_hist) * lane[1]);
+}
@@ -0,0 +1,178 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   client_lz_bonus.c                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fdi-tria <fdi-tria@student.42lausanne.c    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 05:21:08 by fdi-tria          #+#    #+#             */
+/*   Updated: 2026/10/16 05:29:44 by fdi-tria         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "bonus.h"
+
+/**
+ * @brief Hachage des LZ_MIN_MATCH octets situés à une position
+ * @param p Premier octet
+ * @return Index dans la table du compresseur
+ *
+ * Hachage multiplicatif de Knuth sur 32 bits, dont on garde les
+ * LZ_HASH_BITS bits de poids fort, les mieux mélangés.
+ */
+static size_t	ft_lz_hash(const unsigned char *p)
+{
+	uint32_t	v;
+
+	v = p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+	return ((v * 2654435761u) >> (32 - LZ_HASH_BITS));
+}
+
+/**
+ * @brief Écrit les littéraux en attente jusqu'à une position
+ * @param z  État du compresseur
+ * @param to Position (exclue) du dernier littéral à écrire
+ *
+ * Les littéraux partent par séries d'au plus LZ_MAX_LITERALS octets,
+ * chacune précédée de son jeton 0LLLLLLL.
+ */
+static void	ft_lz_literals(t_lzenc *z, size_t to)
+{
+	size_t	n;
+
+	while (z->lit < to)
+	{
+		n = to - z->lit;
+		if (n > LZ_MAX_LITERALS)
+			n = LZ_MAX_LITERALS;
+		z->dst[z->out++] = n - 1;
+		while (n--)
+			z->dst[z->out++] = z->src[z->lit++];
+	}
+}
+
+/**
+ * @brief Longueur commune entre une position antérieure et la courante
+ * @param z    État du compresseur
+ * @param prev Position candidate trouvée dans la table
+ * @param i    Position courante
+ * @return Nombre d'octets identiques, au plus LZ_MAX_MATCH
+ */
+static size_t	ft_lz_match_len(t_lzenc *z, size_t prev, size_t i)
+{
+	size_t	n;
+
+	n = 0;
+	while (n < LZ_MAX_MATCH && i + n < z->len
+		&& z->src[prev + n] == z->src[i + n])
+		n++;
+	return (n);
+}
+
+/**
+ * @brief Compresse un texte au format LZ77 du protocole
+ * @param z   État du compresseur, table comprise
+ * @param src Texte à compresser
+ * @param len Taille de src
+ * @param dst Tampon de len + len / LZ_MAX_LITERALS + 1 octets au moins
+ * @return Taille du flux produit dans dst
+ *
+ * Analyse gloutonne en un seul passage : à chaque position, la table
+ * donne la dernière occurrence des mêmes LZ_MIN_MATCH octets. Si elle
+ * est dans la fenêtre et confirmée, une copie de 3 octets (jeton et
+ * décalage) remplace jusqu'à LZ_MAX_MATCH octets. Sans correspondance,
+ * l'octet rejoint les littéraux : le pire cas ajoute un jeton tous les
+ * LZ_MAX_LITERALS octets.
+ */
+size_t	ft_lz_compress(t_lzenc *z, const char *src, size_t len,
+		unsigned char *dst)
+{
+	size_t	i;
+	size_t	h;
+	size_t	prev;
+	size_t	n;
+
+	z->src = (const unsigned char *)src;
+	z->len = len;
+	z->dst = dst;
+	z->out = 0;
+	z->lit = 0;
+	i = 0;
+	while (i < (1 << LZ_HASH_BITS))
+		z->table[i++] = 0;
+	i = 0;
+	while (i + LZ_MIN_MATCH <= len)
+	{
+		h = ft_lz_hash(z->src + i);
+		prev = z->table[h];
+		z->table[h] = i + 1;
+		n = 0;
+		if (prev && i - (prev - 1) <= LZ_WINDOW)
+			n = ft_lz_match_len(z, prev - 1, i);
+		if (n < LZ_MIN_MATCH)
+		{
+			i++;
+			continue ;
+		}
+		ft_lz_literals(z, i);
+		z->dst[z->out++] = 0x80 | (n - LZ_MIN_MATCH);
+		z->dst[z->out++] = (i - (prev - 1)) >> 8;
+		z->dst[z->out++] = (i - (prev - 1)) & 0xFF;
+		i += n;
+		z->lit = i;
+	}
+	ft_lz_literals(z, len);
+	return (z->out);
+}
+
+/**
+ * @brief Transmet un message compressé bit par bit (option -z)
+ * @param pid     PID du serveur destinataire
+ * @param message Chaîne à transmettre
+ * @param verbose Active le mode debug
+ *
+ * Chaque octet économisé épargne 8 allers-retours de signaux : le coût
+ * de la compression est négligeable à côté. Le message part précédé de
+ * CTL_LZ et de l'en-tête [codec | taille brute | taille compressée].
+ *
+ * Si la compression ne fait rien gagner (texte court ou peu répétitif)
+ * ou si le tampon ne peut être alloué, le message part en clair par
+ * ft_send_message_bonus : le serveur ne voit aucune différence.
+ */
+void	ft_send_message_lz_bonus(pid_t pid, const char *message, int verbose)
+{
+	t_lzenc			z;
+	unsigned char	head[LZ_HEADER + 1];
+	unsigned char	*dst;
+	size_t			len;
+	size_t			i;
+
+	len = 0;
+	while (message[len])
+		len++;
+	dst = malloc(len + len / LZ_MAX_LITERALS + 1);
+	if (!dst || len > UINT32_MAX
+		|| ft_lz_compress(&z, message, len, dst) + LZ_HEADER + 1 >= len + 1)
+	{
+		free(dst);
+		ft_send_message_bonus(pid, message, verbose);
+		return ;
+	}
+	head[0] = CTL_LZ;
+	head[1] = LZ_CODEC;
+	i = 0;
+	while (i++ < 4)
+	{
+		head[1 + i] = len >> (32 - 8 * i);
+		head[5 + i] = z.out >> (32 - 8 * i);
+	}
+	ft_print_colored("Début de la transmission (compressée)...", COLOR_BLUE);
+	i = 0;
+	while (i <= LZ_HEADER)
+		ft_send_char_bonus(pid, head[i++], verbose);
+	i = 0;
+	while (i < z.out)
+		ft_send_char_bonus(pid, dst[i++], verbose);
+	free(dst);
+	ft_wait_done();
+}
@@ -0,0 +1,167 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   client_report_bonus.c                              :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fdi-tria <fdi-tria@student.42lausanne.c    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 05:10:12 by fdi-tria          #+#    #+#             */
+/*   Updated: 2026/10/16 13:34:52 by fdi-tria         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "bonus.h"
+
+extern volatile sig_atomic_t	g_done;
+
+/**
+ * @brief Affiche une durée en microsecondes avec deux décimales
+ * @param ns Durée en nanosecondes
+ */
+static void	ft_put_usec(uint64_t ns)
+{
+	ft_putnbr_u64_bonus(ns / 1000);
+	ft_putchar_bonus('.');
+	ft_putchar_bonus('0' + ns / 100 % 10);
+	ft_putchar_bonus('0' + ns / 10 % 10);
+}
+
+/**
+ * @brief Fenêtre finale, fenêtre maximale et RTT lissé de l'option -w
+ * @param h    Histogramme rempli pendant l'envoi
+ * @param json Champs JSON au lieu d'une ligne du rapport coloré
+ *
+ * Rien n'est affiché hors fenêtre glissante : cwnd_max reste nul.
+ */
+static void	ft_report_window(t_hist *h, int json)
+{
+	if (!h->cwnd_max)
+		return ;
+	if (json)
+		ft_putstr_bonus(",\"cwnd\":");
+	else
+		ft_putstr_bonus(COLOR_GREEN CHECK_MARK COLOR_RESET
+			" Fenêtre finale/max (unités) : ");
+	ft_putnbr_u64_bonus(h->cwnd);
+	if (json)
+		ft_putstr_bonus(",\"cwnd_max\":");
+	else
+		ft_putstr_bonus(" / ");
+	ft_putnbr_u64_bonus(h->cwnd_max);
+	if (json)
+		ft_putstr_bonus(",\"srtt_ns\":");
+	else
+		ft_putstr_bonus(", RTT lissé (µs) : ");
+	if (json)
+		ft_putnbr_u64_bonus(h->srtt);
+	else
+		ft_put_usec(h->srtt);
+	if (!json)
+		ft_putchar_bonus('\n');
+}
+
+/**
+ * @brief Rapport lisible des RTT et du débit
+ * @param h    Histogramme rempli pendant l'envoi
+ * @param rate Débit obtenu en bits par seconde
+ *
+ * Un RTT minimal bas mais un p99 élevé désigne la latence de réveil
+ * de l'ordonnanceur ; un RTT minimal déjà élevé, le coût du
+ * gestionnaire du serveur.
+ */
+static void	ft_report_text(t_hist *h, uint64_t rate)
+{
+	ft_putstr_bonus(COLOR_BLUE "\n=== Statistiques d'envoi ===\n");
+	ft_putstr_bonus(COLOR_GREEN CHECK_MARK COLOR_RESET " Acquittements : ");
+	ft_putnbr_u64_bonus(h->samples);
+	ft_putstr_bonus("\n" COLOR_GREEN CHECK_MARK COLOR_RESET
+		" RTT min/moy/p50/p99/max (µs) : ");
+	ft_put_usec(h->min);
+	ft_putstr_bonus(" / ");
+	ft_put_usec(h->sum / h->samples);
+	ft_putstr_bonus(" / ");
+	ft_put_usec(ft_hist_percentile(h, 500));
+	ft_putstr_bonus(" / ");
+	ft_put_usec(ft_hist_percentile(h, 990));
+	ft_putstr_bonus(" / ");
+	ft_put_usec(h->max);
+	ft_putstr_bonus("\n" COLOR_GREEN CHECK_MARK COLOR_RESET " Débit : ");
+	ft_putnbr_u64_bonus(rate);
+	ft_putstr_bonus(" bits/s\n");
+	ft_report_window(h, 0);
+	ft_putchar_bonus('\n');
+}
+
+/**
+ * @brief Rapport JSON sur une ligne (option -J), valeurs en nanosecondes
+ * @param h    Histogramme rempli pendant l'envoi
+ * @param rate Débit obtenu en bits par seconde
+ */
+static void	ft_report_json(t_hist *h, uint64_t rate)
+{
+	ft_putstr_bonus("{\"samples\":");
+	ft_putnbr_u64_bonus(h->samples);
+	ft_putstr_bonus(",\"min_ns\":");
+	ft_putnbr_u64_bonus(h->min);
+	ft_putstr_bonus(",\"mean_ns\":");
+	ft_putnbr_u64_bonus(h->sum / h->samples);
+	ft_putstr_bonus(",\"p50_ns\":");
+	ft_putnbr_u64_bonus(ft_hist_percentile(h, 500));
+	ft_putstr_bonus(",\"p99_ns\":");
+	ft_putnbr_u64_bonus(ft_hist_percentile(h, 990));
+	ft_putstr_bonus(",\"max_ns\":");
+	ft_putnbr_u64_bonus(h->max);
+	ft_putstr_bonus(",\"bits\":");
+	ft_putnbr_u64_bonus(h->bits);
+	ft_putstr_bonus(",\"elapsed_ns\":");
+	ft_putnbr_u64_bonus(h->last - h->first);
+	ft_putstr_bonus(",\"bits_per_sec\":");
+	ft_putnbr_u64_bonus(rate);
+	ft_report_window(h, 1);
+	ft_putstr_bonus("}\n");
+}
+
+/**
+ * @brief Affiche les statistiques d'envoi à la fin du programme
+ * @param json Format JSON (-J) au lieu du rapport coloré
+ *
+ * Seuls les modes à acquittement individuel (bit par bit, -r) et la
+ * fenêtre glissante (-w, un échantillon par acquittement cumulatif) ont
+ * des allers-retours mesurables ; sans échantillon, rien n'est affiché.
+ */
+void	ft_report_print(int json)
+{
+	t_hist		*h;
+	uint64_t	elapsed;
+	uint64_t	rate;
+
+	h = ft_hist();
+	if (!h->samples)
+		return ;
+	elapsed = h->last - h->first;
+	rate = ft_per_sec(h->bits, elapsed);
+	if (json)
+		ft_report_json(h, rate);
+	else
+		ft_report_text(h, rate);
+}
+
+/**
+ * @brief Attend la confirmation finale du serveur (SIGUSR2)
+ *
+ * SIGUSR2 est bloqué pendant le test de g_done puis débloqué
+ * atomiquement par sigsuspend() : une confirmation arrivée juste avant
+ * l'attente reste en suspens au lieu d'être perdue comme avec pause().
+ */
+void	ft_wait_done(void)
+{
+	sigset_t	block;
+	sigset_t	old;
+
+	sigemptyset(&block);
+	sigaddset(&block, SIGUSR2);
+	sigprocmask(SIG_BLOCK, &block, &old);
+	while (!g_done)
+		sigsuspend(&old);
+	sigprocmask(SIG_SETMASK, &old, NULL);
+}
@@ -0,0 +1,155 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   client_retx_bonus.c                                :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fdi-tria <fdi-tria@student.42lausanne.c    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 15:08:44 by fdi-tria          #+#    #+#             */
+/*   Updated: 2026/10/16 15:31:12 by fdi-tria         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/* Définition des standards POSIX pour sigqueue() et sigtimedwait() */
+#define _POSIX_C_SOURCE 199309L
+#define _XOPEN_SOURCE 700
+#define _DEFAULT_SOURCE
+#include "bonus.h"
+#include <errno.h>
+
+extern volatile sig_atomic_t	g_done;
+
+/**
+ * @brief Accès à l'état de la reprise du mode bit par bit
+ * @return L'état, initialisé au premier appel
+ *
+ * Le premier bit porte le numéro 0, celui qu'attend une session neuve
+ * côté serveur. Le RTO part de CC_RTO_INIT_US, comme la fenêtre.
+ */
+static t_retx	*ft_retx(void)
+{
+	static t_retx	retx;
+	static int		ready;
+
+	if (!ready)
+	{
+		sigemptyset(&retx.set);
+		sigaddset(&retx.set, SIGUSR1);
+		sigaddset(&retx.set, SIGUSR2);
+		retx.seq = 0;
+		ft_cc_init(&retx.cc, 1);
+		ready = 1;
+	}
+	return (&retx);
+}
+
+/**
+ * @brief Attend l'acquittement de l'envoi en cours jusqu'à l'échéance
+ * @param r    État de la reprise, SIGUSR1 et SIGUSR2 bloqués
+ * @param sent Instant de l'envoi, en nanosecondes
+ * @return 1 si l'envoi est acquitté, 0 si le RTO est écoulé
+ *
+ * sigtimedwait() retire l'acquittement sans passer par le gestionnaire,
+ * qui ne verrait pas le numéro attendu. Un SIGUSR1 portant un autre
+ * numéro acquitte un doublon déjà confirmé : il est ignoré et
+ * l'attente reprend pour le temps restant. SIGUSR2, la confirmation
+ * finale, tient lieu d'acquittement du dernier envoi.
+ */
+static int	ft_retx_wait(t_retx *r, uint64_t sent)
+{
+	siginfo_t		info;
+	struct timespec	ts;
+	long			left;
+	int				sig;
+
+	left = r->cc.rto - (long)(ft_now_ns() - sent);
+	while (left > 0)
+	{
+		ts.tv_sec = left / 1000000000L;
+		ts.tv_nsec = left % 1000000000L;
+		sig = sigtimedwait(&r->set, &info, &ts);
+		if (sig == -1 && errno == EAGAIN)
+			return (0);
+		if (sig > 0)
+			ft_trace_rec_bonus(TRACE_ACKED | sig, info.si_pid,
+				info.si_value.sival_int);
+		if (sig == SIGUSR2)
+			g_done = 1;
+		if (sig == SIGUSR2 || (sig == SIGUSR1
+				&& (info.si_value.sival_int & 0xFFFF) == r->seq))
+			return (1);
+		left = r->cc.rto - (long)(ft_now_ns() - sent);
+	}
+	return (0);
+}
+
+/**
+ * @brief Émet un envoi numéroté et attend son acquittement, avec reprise
+ * @param pid  PID du serveur destinataire
+ * @param sig  Signal porteur : SIGUSR1/SIGUSR2 pour un bit, temps réel
+ *             pour un mot (RT_WORD)
+ * @param data Octets portés par la valeur (mot), 0 pour un bit
+ * @param bits Bits du message couverts par l'envoi, pour l'histogramme
+ *
+ * Le numéro voyage dans les 16 bits de poids faible de la valeur de
+ * sigqueue(), les données dans les 16 de poids fort, comme en mode
+ * fenêtre glissante ; il revient dans la valeur de l'acquittement. Un
+ * envoi perdu (bit fusionné avec le même signal d'un autre client) ou
+ * un acquittement perdu n'est jamais confirmé : l'envoi est répété à
+ * l'échéance, et le serveur se contente d'acquitter de nouveau un
+ * doublon. Le RTO double à chaque échéance ; seuls les envois acquittés
+ * du premier coup alimentent sa mesure (algorithme de Karn). Après
+ * BIT_RETX_MAX envois sans réponse, le client abandonne au lieu
+ * d'attendre indéfiniment. Bits et mots partagent la même numérotation,
+ * comme la session qui les reçoit côté serveur.
+ */
+void	ft_retx_unit(pid_t pid, int sig, unsigned int data, int bits)
+{
+	t_retx			*r;
+	union sigval	value;
+	sigset_t		old;
+	uint64_t		sent;
+	int				tries;
+	int				acked;
+
+	r = ft_retx();
+	value.sival_int = (int)(data << 16 | (unsigned int)r->seq);
+	sigprocmask(SIG_BLOCK, &r->set, &old);
+	tries = 0;
+	acked = 0;
+	while (!acked && tries++ < BIT_RETX_MAX)
+	{
+		sent = ft_now_ns();
+		ft_trace_rec_bonus(TRACE_SEND | sig, pid, value.sival_int);
+		if (sigqueue(pid, sig, value) == -1)
+		{
+			ft_print_colored("Erreur: Échec de l'envoi du signal", COLOR_RED);
+			exit(1);
+		}
+		acked = ft_retx_wait(r, sent);
+		if (!acked)
+			r->cc.rto *= 2;
+		if (r->cc.rto > CC_RTO_MAX_US * 1000L)
+			r->cc.rto = CC_RTO_MAX_US * 1000L;
+	}
+	sigprocmask(SIG_SETMASK, &old, NULL);
+	if (!acked)
+	{
+		ft_print_colored("Erreur: Le serveur ne répond plus", COLOR_RED);
+		exit(1);
+	}
+	if (tries == 1)
+		ft_cc_rtt(&r->cc, (long)(ft_now_ns() - sent));
+	ft_hist_record(sent, ft_now_ns(), bits);
+	r->seq = (r->seq + 1) & 0xFFFF;
+}
+
+/**
+ * @brief Émet un bit numéroté et attend son acquittement, avec reprise
+ * @param pid PID du serveur destinataire
+ * @param sig SIGUSR1 pour un bit à 0, SIGUSR2 pour un bit à 1
+ */
+void	ft_retx_send(pid_t pid, int sig)
+{
+	ft_retx_unit(pid, sig, 0, 1);
+}
@@ -0,0 +1,164 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   client_rt_bonus.c                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fdi-tria <fdi-tria@student.42lausanne.c    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 04:51:19 by fdi-tria          #+#    #+#             */
+/*   Updated: 2026/10/16 15:31:12 by fdi-tria         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/* Définition des standards POSIX pour SIGRTMIN */
+#define _POSIX_C_SOURCE 199309L
+#define _XOPEN_SOURCE 700
+#define _DEFAULT_SOURCE
+#include "bonus.h"
+
+/**
+ * @brief Affiche en mode verbeux le mot de 16 bits en cours d'envoi
+ * @param word Mot à afficher en hexadécimal
+ * 
+ * Pendant du "Envoi bit: X" du mode classique : l'hexadécimal permet
+ * de retrouver directement les 2 octets transportés par le signal.
+ */
+static void	ft_send_word_verbose(unsigned int word)
+{
+	const char	*hex;
+	int			shift;
+
+	hex = "0123456789ABCDEF";
+	ft_putstr_bonus(COLOR_BLUE);
+	ft_putstr_bonus("Envoi mot: 0x");
+	shift = 12;
+	while (shift >= 0)
+	{
+		ft_putchar_bonus(hex[(word >> shift) & 0xF]);
+		shift -= 4;
+	}
+	ft_putchar_bonus('\n');
+	ft_putstr_bonus(COLOR_RESET);
+}
+
+/**
+ * @brief Regroupe jusqu'à 2 octets du message dans un mot de 16 bits
+ * @param message Chaîne à transmettre
+ * @param i       Position courante dans le message (avancée ici)
+ * @param done    Passe à 1 dès que le '\0' terminal a été empaqueté
+ * @return Le mot construit, premier octet dans les bits de poids fort
+ * 
+ * L'ordre MSB first du mode bit par bit est conservé. Après le '\0',
+ * le mot est complété par des zéros que le serveur ignore puisque
+ * la session est close dès le traitement du caractère nul.
+ */
+static unsigned int	ft_pack_word_bonus(const char *message, size_t *i,
+		int *done)
+{
+	unsigned int	word;
+	int				n;
+
+	word = 0;
+	n = 0;
+	while (n < 2)
+	{
+		word = word << 8;
+		if (!*done)
+		{
+			word = word | (unsigned char)message[*i];
+			if (!message[*i])
+				*done = 1;
+			(*i)++;
+		}
+		n++;
+	}
+	return (word);
+}
+
+/**
+ * @brief Transmet un mot de 16 bits via sigqueue() et attend l'acquittement
+ * @param pid     PID du serveur destinataire
+ * @param word    Mot à placer dans les 16 bits de poids fort de la valeur
+ * @param verbose Active l'affichage du mot envoyé
+ * 
+ * Les signaux temps réel (SIGRTMIN..SIGRTMAX) sont mis en file par le
+ * noyau au lieu d'être fusionnés, et sigqueue() leur attache une valeur
+ * que le serveur lit dans siginfo_t->si_value. Les 16 bits de poids
+ * faible portent le numéro de l'envoi : l'attente, l'échéance et la
+ * reprise sont celles du mode bit par bit (ft_retx_unit), et un mot
+ * répété n'est décodé qu'une fois. Chaque aller-retour compte pour
+ * 16 bits dans l'histogramme des RTT.
+ */
+static void	ft_send_word_bonus(pid_t pid, unsigned int word, int verbose)
+{
+	if (verbose)
+		ft_send_word_verbose(word);
+	ft_retx_unit(pid, SIGRTMIN + RT_WORD, word, 16);
+}
+
+/**
+ * @brief Transmet un message complet par mots de 16 bits (option -r)
+ * @param pid     PID du serveur destinataire
+ * @param message Chaîne à transmettre
+ * @param verbose Active le mode debug
+ * 
+ * Équivalent temps réel de ft_send_message_bonus : le '\0' terminal
+ * est inclus dans le dernier mot, puis le client attend la confirmation
+ * finale (SIGUSR2). Un message de n caractères coûte (n + 1) / 2
+ * signaux arrondis au supérieur au lieu de 8 * (n + 1). Un premier
+ * octet réservé est précédé de CTL_ESC, envoyé bit par bit.
+ * 
+ * @note Comme la version bit par bit, la fonction ne retourne qu'après
+ *       la confirmation SIGUSR2
+ */
+void	ft_send_message_rt_bonus(pid_t pid, const char *message, int verbose)
+{
+	size_t	i;
+	int		done;
+
+	i = 0;
+	done = 0;
+	ft_print_colored("Début de la transmission (temps réel)...", COLOR_BLUE);
+	if ((unsigned char)message[0] >= CTL_SYM)
+		ft_send_char_bonus(pid, CTL_ESC, verbose);
+	while (!done)
+		ft_send_word_bonus(pid, ft_pack_word_bonus(message, &i, &done),
+			verbose);
+	ft_wait_done();
+}
+
+/**
+ * @brief Transmet des octets quelconques par mots de 16 bits
+ * @param pid     PID du serveur destinataire
+ * @param data    Octets à transmettre, '\0' compris
+ * @param len     Nombre d'octets
+ * @param verbose Active le mode debug
+ * 
+ * Variante de ft_send_message_rt_bonus pour un contenu dont la fin est
+ * connue du serveur par une taille annoncée : aucun '\0' n'est ajouté
+ * et le dernier mot est complété par des zéros. Ne bloque pas en
+ * attente de la confirmation finale.
+ */
+void	ft_send_words_bonus(pid_t pid, const void *data, size_t len,
+			int verbose)
+{
+	const unsigned char	*bytes;
+	unsigned int		word;
+	size_t				i;
+	int					n;
+
+	bytes = data;
+	i = 0;
+	while (i < len)
+	{
+		word = 0;
+		n = 0;
+		while (n++ < 2)
+		{
+			word = word << 8;
+			if (i < len)
+				word = word | bytes[i++];
+		}
+		ft_send_word_bonus(pid, word, verbose);
+	}
+}
@@ -0,0 +1,168 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   client_shm_bonus.c                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fdi-tria <fdi-tria@student.42lausanne.c    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 04:57:00 by fdi-tria          #+#    #+#             */
+/*   Updated: 2026/10/16 14:21:12 by fdi-tria         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/* Définition des standards POSIX pour shm_open() et sigqueue() */
+#define _POSIX_C_SOURCE 199309L
+#define _XOPEN_SOURCE 700
+#define _DEFAULT_SOURCE
+#include "bonus.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+
+extern volatile sig_atomic_t	g_signal_received;
+
+/**
+ * @brief Ouvre et projette l'anneau créé par le serveur
+ * @param pid PID du serveur
+ * @return L'anneau, ou NULL si le serveur ne l'a pas créé
+ */
+static t_ring	*ft_shm_map(pid_t pid)
+{
+	char	name[SHM_NAME_MAX];
+	int		fd;
+	void	*map;
+
+	ft_shm_name(name, pid, getpid());
+	fd = shm_open(name, O_RDWR, 0600);
+	map = MAP_FAILED;
+	if (fd != -1)
+	{
+		map = mmap(NULL, sizeof(t_ring) + SHM_RING_SIZE,
+				PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+		close(fd);
+	}
+	if (map != MAP_FAILED)
+		return (map);
+	ft_print_colored("Mémoire partagée indisponible, envoi bit par bit",
+		COLOR_YELLOW);
+	return (NULL);
+}
+
+/**
+ * @brief Copie dans l'anneau autant d'octets que la place le permet
+ * @param ring Anneau partagé
+ * @param buf  Octets à publier
+ * @param len  Nombre d'octets disponibles dans buf
+ * @param pid  PID du serveur, réveillé si l'anneau était vide
+ * @return Nombre d'octets publiés, 0 si l'anneau est plein
+ * 
+ * Les octets sont copiés avant la publication de tail : le serveur ne
+ * lit jamais une case que le client n'a pas fini d'écrire. La sonnette
+ * n'est tirée que si le serveur avait déjà tout consommé (head égal à
+ * l'ancien tail) : tant qu'il vide l'anneau, il relit tail lui-même.
+ */
+static size_t	ft_ring_push(t_ring *ring, const char *buf, size_t len,
+		pid_t pid)
+{
+	size_t			tail;
+	size_t			n;
+	size_t			i;
+	union sigval	value;
+
+	tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+	n = ring->size - (tail - atomic_load(&ring->head));
+	if (n > len)
+		n = len;
+	i = 0;
+	while (i < n)
+	{
+		ring->data[(tail + i) & (ring->size - 1)] = buf[i];
+		i++;
+	}
+	atomic_store(&ring->tail, tail + n);
+	value.sival_int = 0;
+	if (!n || atomic_load(&ring->head) != tail)
+		return (n);
+	ft_trace_rec_bonus(TRACE_SEND | (SIGRTMIN + RT_DOORBELL), pid, 0);
+	if (sigqueue(pid, SIGRTMIN + RT_DOORBELL, value) == -1)
+	{
+		ft_print_colored("Erreur: Échec de l'envoi du signal", COLOR_RED);
+		exit(1);
+	}
+	return (n);
+}
+
+/**
+ * @brief Attend que le serveur libère de la place dans l'anneau
+ * @param ring Anneau partagé, plein au moment de l'appel
+ * 
+ * SIGUSR1 est bloqué pendant le test puis débloqué atomiquement par
+ * sigsuspend() : un réveil arrivé entre le test et l'attente reste en
+ * suspens au lieu d'être perdu comme avec pause(). waiting est levé
+ * avant de relire head, pour que le serveur ou le client voie l'autre.
+ */
+static void	ft_ring_wait(t_ring *ring)
+{
+	sigset_t	block;
+	sigset_t	old;
+
+	sigemptyset(&block);
+	sigaddset(&block, SIGUSR1);
+	sigprocmask(SIG_BLOCK, &block, &old);
+	g_signal_received = 0;
+	atomic_store(&ring->waiting, 1);
+	while (!g_signal_received && atomic_load(&ring->tail)
+		- atomic_load(&ring->head) == ring->size)
+		sigsuspend(&old);
+	atomic_store(&ring->waiting, 0);
+	sigprocmask(SIG_SETMASK, &old, NULL);
+}
+
+/**
+ * @brief Transmet un message par l'anneau en mémoire partagée (option -m)
+ * @param pid     PID du serveur destinataire
+ * @param message Chaîne à transmettre
+ * @param verbose Active le mode debug de la poignée de main
+ * 
+ * 1. Poignée de main : l'octet CTL_SHM part bit par bit, le serveur
+ *    crée le segment avant d'acquitter son dernier bit
+ * 2. Le message, '\0' compris, est copié par blocs dans l'anneau ;
+ *    les signaux ne servent plus que de sonnette
+ * 3. Si le segment est introuvable, le message est envoyé bit par bit :
+ *    le serveur a ignoré CTL_SHM et attend la suite du texte
+ * 
+ * Seule la poignée de main a des allers-retours mesurables : ses
+ * échantillons sont écartés pour ne pas fausser le débit rapporté.
+ * 
+ * @note La fonction rend la main après la confirmation du '\0' par
+ *       SIGUSR2
+ */
+void	ft_send_message_shm_bonus(pid_t pid, const char *message, int verbose)
+{
+	t_ring	*ring;
+	size_t	len;
+	size_t	sent;
+	size_t	n;
+
+	ft_send_char_bonus(pid, CTL_SHM, verbose);
+	ring = ft_shm_map(pid);
+	if (!ring)
+	{
+		ft_send_message_bonus(pid, message, verbose);
+		return ;
+	}
+	ft_hist_reset();
+	ft_print_colored("Début de la transmission (mémoire partagée)...",
+		COLOR_BLUE);
+	len = 0;
+	while (message[len])
+		len++;
+	sent = 0;
+	while (sent <= len)
+	{
+		n = ft_ring_push(ring, message + sent, len + 1 - sent, pid);
+		if (!n)
+			ft_ring_wait(ring);
+		sent += n;
+	}
+	ft_wait_done();
+}
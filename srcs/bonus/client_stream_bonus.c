@@ -0,0 +1,128 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   client_stream_bonus.c                              :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fdi-tria <fdi-tria@student.42lausanne.c    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 06:11:45 by fdi-tria          #+#    #+#             */
+/*   Updated: 2026/10/16 06:44:20 by fdi-tria         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/* Définition des standards POSIX pour aio_read() */
+#define _POSIX_C_SOURCE 199309L
+#define _XOPEN_SOURCE 700
+#define _DEFAULT_SOURCE
+#include "bonus.h"
+#include <errno.h>
+#include <fcntl.h>
+
+/**
+ * @brief Lance la lecture du prochain morceau dans le tampon courant
+ * @param st État de la lecture
+ * @return 1 si la lecture est lancée, 0 en cas d'erreur
+ *
+ * aio_read() rend la main immédiatement : glibc lit depuis un thread
+ * auxiliaire qui bloque tous les signaux, les acquittements du serveur
+ * continuent donc d'arriver au thread principal. Sur un tube, la
+ * position est ignorée et glibc se replie sur read().
+ */
+static int	ft_stream_read(t_stream *st)
+{
+	st->cb.aio_fildes = st->fd;
+	st->cb.aio_buf = st->buf[st->cur];
+	st->cb.aio_nbytes = STREAM_CHUNK;
+	st->cb.aio_offset = st->off;
+	st->cb.aio_sigevent.sigev_notify = SIGEV_NONE;
+	return (aio_read(&st->cb) == 0);
+}
+
+/**
+ * @brief Ouvre le fichier à envoyer et lance la première lecture
+ * @param st   État de la lecture, mis à zéro (statique : deux morceaux
+ *             ne tiennent pas raisonnablement sur la pile)
+ * @param path Chemin du fichier, "-" pour l'entrée standard
+ * @return 1 en cas de succès, 0 si le fichier est illisible
+ */
+int	ft_stream_open(t_stream *st, const char *path)
+{
+	st->fd = 0;
+	if (path[0] != '-' || path[1])
+		st->fd = open(path, O_RDONLY);
+	st->cur = 0;
+	st->off = 0;
+	return (st->fd != -1 && ft_stream_read(st));
+}
+
+/**
+ * @brief Attend le morceau en cours de lecture et lance le suivant
+ * @param st   État de la lecture
+ * @param data Reçoit l'adresse du morceau lu
+ * @return Taille du morceau, 0 en fin de fichier, -1 en cas d'erreur
+ *
+ * aio_suspend() peut être interrompu par un signal du serveur : l'attente
+ * reprend tant que la lecture est en cours. Le morceau rendu reste
+ * valide jusqu'à l'appel suivant, pendant lequel l'autre tampon se
+ * remplit.
+ */
+ssize_t	ft_stream_next(t_stream *st, const unsigned char **data)
+{
+	const struct aiocb	*list[1];
+	ssize_t				n;
+
+	list[0] = &st->cb;
+	while (aio_error(&st->cb) == EINPROGRESS)
+		aio_suspend(list, 1, NULL);
+	n = aio_return(&st->cb);
+	if (n <= 0)
+		return (n);
+	*data = st->buf[st->cur];
+	st->off += n;
+	st->cur = !st->cur;
+	if (!ft_stream_read(st))
+		return (-1);
+	return (n);
+}
+
+/**
+ * @brief Transmet un fichier ou l'entrée standard (option -f)
+ * @param pid     PID du serveur destinataire
+ * @param path    Chemin du fichier, "-" pour l'entrée standard
+ * @param verbose Active le mode debug
+ *
+ * Le contenu n'est jamais chargé en entier : chaque morceau de
+ * STREAM_CHUNK octets part dans une trame à longueur préfixée marquée
+ * FRAME_F_MORE, pendant que le morceau suivant est lu. La taille totale
+ * n'a pas besoin d'être connue : une trame vide sans drapeau clôt le
+ * message à la fin du fichier. Les trames rendent l'envoi sûr pour les
+ * fichiers binaires.
+ */
+void	ft_send_file_bonus(pid_t pid, const char *path, int verbose)
+{
+	static t_stream		st;
+	const unsigned char	*data;
+	ssize_t				n;
+
+	if (!ft_stream_open(&st, path))
+	{
+		ft_print_colored("Erreur: Lecture du fichier impossible", COLOR_RED);
+		exit(1);
+	}
+	ft_print_colored("Début de la transmission (fichier)...", COLOR_BLUE);
+	ft_send_char_bonus(pid, CTL_FRAME, verbose);
+	n = ft_stream_next(&st, &data);
+	while (n > 0)
+	{
+		ft_send_frame_head_bonus(pid, n, FRAME_F_MORE, verbose);
+		ft_send_bytes_bonus(pid, data, n, verbose);
+		n = ft_stream_next(&st, &data);
+	}
+	if (n < 0)
+	{
+		ft_print_colored("Erreur: Lecture du fichier interrompue", COLOR_RED);
+		exit(1);
+	}
+	ft_send_frame_head_bonus(pid, 0, 0, verbose);
+	ft_wait_done();
+}
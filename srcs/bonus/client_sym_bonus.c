@@ -0,0 +1,146 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   client_sym_bonus.c                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fdi-tria <fdi-tria@student.42lausanne.c    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 08:14:03 by fdi-tria          #+#    #+#             */
+/*   Updated: 2026/10/16 15:38:27 by fdi-tria         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/* Définition des standards POSIX pour sigtimedwait() et SIGRTMIN */
+#define _POSIX_C_SOURCE 199309L
+#define _XOPEN_SOURCE 700
+#define _DEFAULT_SOURCE
+#include "bonus.h"
+#include <errno.h>
+
+/**
+ * @brief Convertit la taille d'alphabet demandée en bits par symbole
+ * @param n Nombre de signaux demandé avec -a
+ * @return log2(n), ou 0 si n n'est pas une puissance de 2 entre 2 et
+ *         2^SYM_MAX_BITS
+ */
+int	ft_sym_bits(int n)
+{
+	int	bits;
+
+	bits = 1;
+	while (bits < SYM_MAX_BITS && (1 << bits) < n)
+		bits++;
+	if (n < 2 || (1 << bits) != n)
+		return (0);
+	return (bits);
+}
+
+/**
+ * @brief Négocie le nombre de bits par symbole avec le serveur
+ * @param pid     PID du serveur destinataire
+ * @param bits    Bits par symbole demandés avec -a
+ * @param verbose Active le mode debug de la poignée de main
+ * @return Bits par symbole retenus par le serveur
+ *
+ * CTL_SYM puis la proposition partent bit par bit. SIGRTMIN + RT_ACK
+ * est bloqué avant : la réponse du serveur, envoyée avant
+ * l'acquittement du dernier bit, reste en file jusqu'à sigtimedwait(),
+ * comme en mode fenêtre glissante. Elle devrait donc déjà attendre ;
+ * l'attente est tout de même bornée à BIT_RETX_MAX fois CC_RTO_MAX_US,
+ * ce que tolère la reprise d'un bit, avant d'abandonner comme les
+ * autres modes.
+ */
+static int	ft_sym_negotiate(pid_t pid, int bits, int verbose)
+{
+	sigset_t		set;
+	siginfo_t		info;
+	struct timespec	ts;
+	int				tries;
+
+	sigemptyset(&set);
+	sigaddset(&set, SIGRTMIN + RT_ACK);
+	sigprocmask(SIG_BLOCK, &set, NULL);
+	ft_send_char_bonus(pid, CTL_SYM, verbose);
+	ft_send_char_bonus(pid, bits, verbose);
+	ts.tv_sec = CC_RTO_MAX_US / 1000000;
+	ts.tv_nsec = CC_RTO_MAX_US % 1000000 * 1000L;
+	tries = 0;
+	while (sigtimedwait(&set, &info, &ts) == -1)
+	{
+		if (errno == EAGAIN && ++tries >= BIT_RETX_MAX)
+		{
+			ft_print_colored("Erreur: Le serveur ne répond plus", COLOR_RED);
+			exit(1);
+		}
+	}
+	return (info.si_value.sival_int);
+}
+
+/**
+ * @brief Envoie un symbole par le numéro du signal et attend l'acquittement
+ * @param pid     PID du serveur destinataire
+ * @param sym     Symbole, de 0 à 2^bits - 1
+ * @param bits    Bits portés par le symbole
+ * @param verbose Active l'affichage du symbole envoyé
+ *
+ * La valeur attachée par sigqueue() ne porte que le numéro de l'envoi :
+ * l'attente, l'échéance et la reprise sont celles du mode bit par bit
+ * (ft_retx_unit), et un symbole répété n'est décodé qu'une fois.
+ * Chaque aller-retour compte pour bits bits dans l'histogramme des RTT.
+ */
+static void	ft_send_symbol(pid_t pid, int sym, int bits, int verbose)
+{
+	if (verbose)
+	{
+		ft_putstr_bonus(COLOR_BLUE "Envoi symbole: ");
+		ft_putnbr_bonus(sym);
+		ft_putstr_bonus("\n" COLOR_RESET);
+	}
+	ft_retx_unit(pid, SIGRTMIN + RT_SYM + sym, 0, bits);
+}
+
+/**
+ * @brief Transmet un message par symboles de plusieurs bits (option -a N)
+ * @param pid     PID du serveur destinataire
+ * @param message Chaîne à transmettre
+ * @param opts    Options du client (bits par symbole, mode verbeux)
+ *
+ * Au lieu de deux signaux (SIGUSR1 = 0, SIGUSR2 = 1), le client choisit
+ * parmi 2^bits signaux temps réel : chaque signal porte bits bits du
+ * message. Les octets, '\0' compris, sont mis bout à bout poids fort
+ * d'abord puis découpés en symboles ; le dernier est complété par des
+ * zéros. Avec 16 symboles, un octet coûte 2 allers-retours au lieu de 8.
+ *
+ * Seule la négociation a des allers-retours d'un bit : ses échantillons
+ * sont écartés pour ne pas fausser le débit rapporté.
+ */
+void	ft_send_message_sym_bonus(pid_t pid, const char *message,
+		t_opts *opts)
+{
+	unsigned int	acc;
+	int				nacc;
+	int				bits;
+	size_t			i;
+
+	bits = ft_sym_negotiate(pid, opts->alphabet, opts->verbose);
+	ft_hist_reset();
+	ft_print_colored("Début de la transmission (symboles)...", COLOR_BLUE);
+	acc = 0;
+	nacc = 0;
+	i = 0;
+	while (i == 0 || message[i - 1])
+	{
+		acc = (acc << 8) | (unsigned char)message[i++];
+		nacc += 8;
+		while (nacc >= bits)
+		{
+			nacc -= bits;
+			ft_send_symbol(pid, (acc >> nacc) & ((1 << bits) - 1), bits,
+				opts->verbose);
+		}
+	}
+	if (nacc)
+		ft_send_symbol(pid, (acc << (bits - nacc)) & ((1 << bits) - 1),
+			bits, opts->verbose);
+	ft_wait_done();
+}
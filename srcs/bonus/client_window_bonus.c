@@ -0,0 +1,247 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   client_window_bonus.c                              :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fdi-tria <fdi-tria@student.42lausanne.c    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 04:53:21 by fdi-tria          #+#    #+#             */
+/*   Updated: 2026/10/16 16:19:02 by fdi-tria         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/* Définition des standards POSIX pour sigqueue() et sigtimedwait() */
+#define _POSIX_C_SOURCE 199309L
+#define _XOPEN_SOURCE 700
+#define _DEFAULT_SOURCE
+#include "bonus.h"
+#include <errno.h>
+#include <sys/resource.h>
+
+extern volatile sig_atomic_t	g_done;
+
+/**
+ * @brief Prépare l'état de l'émetteur et borne la taille de la fenêtre
+ * @param w         État à initialiser
+ * @param pid       PID du serveur destinataire
+ * @param message   Chaîne à transmettre
+ * @param requested Taille de fenêtre demandée avec -w
+ * 
+ * Chaque unité en vol occupe une entrée de la file de signaux temps réel
+ * du serveur, limitée par RLIMIT_SIGPENDING. La fenêtre est donc bornée
+ * à la moitié de cette limite (le reste est laissé aux autres émetteurs)
+ * et à SEQ_MAX_WINDOW pour que les numéros de séquence sur 16 bits
+ * restent non ambigus. Cette borne n'est qu'un plafond : le contrôleur
+ * (client_cc_bonus.c) décide combien d'unités sont réellement en vol.
+ */
+static void	ft_window_init(t_window *w, pid_t pid, const char *message,
+		int requested)
+{
+	struct rlimit	limit;
+
+	w->pid = pid;
+	w->message = message;
+	w->len = 0;
+	while (message[w->len])
+		w->len++;
+	w->base = 0;
+	w->next = 0;
+	w->high = 0;
+	w->karn = 0;
+	w->total = (w->len + SEQ_UNIT_BYTES) / SEQ_UNIT_BYTES;
+	w->size = requested;
+	if (w->size > SEQ_MAX_WINDOW)
+		w->size = SEQ_MAX_WINDOW;
+	if (getrlimit(RLIMIT_SIGPENDING, &limit) == 0
+		&& limit.rlim_cur != RLIM_INFINITY && w->size > limit.rlim_cur / 2)
+		w->size = limit.rlim_cur / 2;
+	if (w->size < 1)
+		w->size = 1;
+	w->sent = malloc(sizeof(uint64_t) * w->size);
+	if (!w->sent)
+	{
+		ft_print_colored("Erreur: Mémoire insuffisante", COLOR_RED);
+		exit(1);
+	}
+	ft_cc_init(&w->cc, w->size);
+}
+
+/**
+ * @brief Construit l'unité numérotée d'index idx
+ * @param w   État de l'émetteur
+ * @param idx Index absolu de l'unité dans le message
+ * @return [seq:16 | octet 2*idx:8 | octet 2*idx+1:8]
+ * 
+ * Le '\0' terminal fait partie du message transmis ; au-delà, l'unité
+ * est complétée par un octet nul que le serveur ignore.
+ */
+static unsigned int	ft_pack_unit(t_window *w, size_t idx)
+{
+	unsigned int	unit;
+	size_t			pos;
+	int				n;
+
+	unit = idx & 0xFFFF;
+	pos = idx * SEQ_UNIT_BYTES;
+	n = 0;
+	while (n < SEQ_UNIT_BYTES)
+	{
+		unit = unit << 8;
+		if (pos + n < w->len)
+			unit = unit | (unsigned char)w->message[pos + n];
+		n++;
+	}
+	return (unit);
+}
+
+/**
+ * @brief Envoie l'unité w->next sans attendre d'acquittement
+ * @param w       État de l'émetteur
+ * @param verbose Active l'affichage du numéro de séquence
+ * @return 1 si l'unité est partie, 0 si la file du serveur est pleine
+ * 
+ * EAGAIN signifie que RLIMIT_SIGPENDING est atteint côté serveur :
+ * l'unité n'est pas perdue, elle sera retentée après un acquittement,
+ * mais la fenêtre est réduite comme après une hausse du RTT. Toute
+ * autre erreur termine le programme comme en mode bit par bit.
+ */
+static int	ft_send_unit(t_window *w, int verbose)
+{
+	union sigval	value;
+
+	value.sival_int = (int)ft_pack_unit(w, w->next);
+	ft_trace_rec_bonus(TRACE_SEND | (SIGRTMIN + RT_SEQ), w->pid,
+		value.sival_int);
+	if (sigqueue(w->pid, SIGRTMIN + RT_SEQ, value) == -1)
+	{
+		if (errno != EAGAIN)
+		{
+			ft_print_colored("Erreur: Échec de l'envoi du signal", COLOR_RED);
+			exit(1);
+		}
+		ft_cc_cut(&w->cc, w->next, 0, verbose);
+		return (0);
+	}
+	w->sent[w->next % w->size] = ft_now_ns();
+	if (verbose)
+	{
+		ft_putstr_bonus(COLOR_BLUE "Envoi unité: ");
+		ft_putnbr_bonus(w->next & 0xFFFF);
+		ft_putstr_bonus("\n" COLOR_RESET);
+	}
+	w->next++;
+	if (w->next > w->high)
+		w->high = w->next;
+	return (1);
+}
+
+/**
+ * @brief Attend un acquittement cumulatif et fait glisser la fenêtre
+ * @param w       État de l'émetteur
+ * @param set     Ensemble contenant SIGRTMIN + RT_ACK, bloqué au préalable
+ * @param verbose Mode verbeux du client
+ * 
+ * sigtimedwait() consomme l'acquittement de façon synchrone : pas de
+ * gestionnaire, donc pas de course entre le test et la mise en attente
+ * comme avec pause(). L'acquittement porte le numéro de la prochaine
+ * unité attendue ; un numéro hors de la fenêtre (doublon) est ignoré.
+ * Le RTT mesuré est celui de la dernière unité acquittée, la plus
+ * récente couverte par l'acquittement cumulatif. EINTR signale la
+ * confirmation finale SIGUSR2, traitée par la boucle d'envoi.
+ *
+ * Sans acquittement avant le RTO (EAGAIN), la fenêtre repart de 1 et
+ * l'envoi reprend à w->base (go-back-N) : le serveur écarte toute
+ * unité qui suit un trou, une unité perdue doit donc être renvoyée
+ * avec toutes celles qui la suivent. Un acquittement en retard peut
+ * encore couvrir les unités envoyées avant ce retour, jusqu'à w->high.
+ * Ces unités sont parties deux fois et w->sent ne garde que le dernier
+ * envoi : l'acquittement peut répondre à l'un ou à l'autre. Comme dans
+ * client_fan.c, seules les unités envoyées une seule fois (à partir de
+ * w->karn) alimentent l'estimateur du RTT (algorithme de Karn).
+ */
+static void	ft_wait_ack(t_window *w, const sigset_t *set, int verbose)
+{
+	siginfo_t		info;
+	struct timespec	rto;
+	size_t			delta;
+	uint64_t		sent;
+	uint64_t		now;
+
+	rto.tv_sec = w->cc.rto / 1000000000L;
+	rto.tv_nsec = w->cc.rto % 1000000000L;
+	if (sigtimedwait(set, &info, &rto) == -1)
+	{
+		if (errno == EAGAIN)
+		{
+			ft_cc_cut(&w->cc, w->next, 1, verbose);
+			w->next = w->base;
+			w->karn = w->high;
+		}
+		return ;
+	}
+	ft_trace_rec_bonus(TRACE_ACKED | info.si_signo, info.si_pid,
+		info.si_value.sival_int);
+	now = ft_now_ns();
+	delta = (info.si_value.sival_int - w->base) & 0xFFFF;
+	if (!delta || delta > w->high - w->base)
+		return ;
+	sent = w->sent[(w->base + delta - 1) % w->size];
+	ft_hist_record(sent, now, delta * SEQ_UNIT_BYTES * 8);
+	w->base += delta;
+	if (w->next < w->base)
+		w->next = w->base;
+	if (w->base <= w->karn)
+		ft_cc_ack(&w->cc, w->base, -1, verbose);
+	else
+		ft_cc_ack(&w->cc, w->base, (long)(now - sent), verbose);
+}
+
+/**
+ * @brief Transmet un message avec une fenêtre glissante d'unités (-w N)
+ * @param pid     PID du serveur destinataire
+ * @param message Chaîne à transmettre
+ * @param opts    Options du client (taille de fenêtre, mode verbeux)
+ * 
+ * Au lieu d'attendre un acquittement après chaque signal, le client
+ * garde jusqu'à w.cc.cwnd unités numérotées en vol sur SIGRTMIN + RT_SEQ,
+ * cwnd s'adaptant à la charge du serveur sans dépasser w.size.
+ * Les signaux temps réel étant mis en file, aucune unité ne peut être
+ * fusionnée avec une autre ; le débit ne dépend plus de la latence de
+ * réveil du client à chaque aller-retour.
+ * 
+ * Un premier octet réservé est précédé de CTL_ESC, envoyé bit par bit
+ * avant la première unité : la numérotation des unités n'en dépend pas.
+ *
+ * @note Le serveur confirme la dernière unité par SIGUSR2 et non par
+ *       un acquittement cumulatif : g_done interrompt alors la boucle
+ */
+void	ft_send_message_window_bonus(pid_t pid, const char *message,
+		t_opts *opts)
+{
+	t_window	w;
+	sigset_t	set;
+
+	ft_window_init(&w, pid, message, opts->window);
+	if ((unsigned char)message[0] >= CTL_SYM)
+		ft_send_char_bonus(pid, CTL_ESC, opts->verbose);
+	sigemptyset(&set);
+	sigaddset(&set, SIGRTMIN + RT_ACK);
+	sigprocmask(SIG_BLOCK, &set, NULL);
+	ft_print_colored("Début de la transmission (fenêtre glissante)...",
+		COLOR_BLUE);
+	while (w.base < w.total && !g_done)
+	{
+		while (w.next < w.total && w.next - w.base < w.cc.cwnd
+			&& ft_send_unit(&w, opts->verbose))
+			continue ;
+		if (w.next > w.base)
+			ft_wait_ack(&w, &set, opts->verbose);
+		else
+			usleep(1000);
+	}
+	ft_wait_done();
+	free(w.sent);
+	ft_hist()->cwnd = w.cc.cwnd;
+	ft_hist()->cwnd_max = w.cc.cwnd_max;
+	ft_hist()->srtt = w.cc.srtt;
+}
@@ -0,0 +1,120 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   output_bonus.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fdi-tria <fdi-tria@student.42lausanne.c    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 05:02:03 by fdi-tria          #+#    #+#             */
+/*   Updated: 2026/10/16 05:02:03 by fdi-tria         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/* Définition des standards POSIX pour sigaction() et setitimer() */
+#define _POSIX_C_SOURCE 199309L
+#define _XOPEN_SOURCE 700
+#define _DEFAULT_SOURCE
+#include "bonus.h"
+
+/**
+ * @brief Tampon de sortie partagé par toutes les fonctions d'affichage
+ * 
+ * Statique et de taille fixe : aucune allocation, il peut donc être
+ * rempli depuis un gestionnaire de signaux.
+ */
+static t_out	g_out;
+
+/**
+ * @brief Écrit le contenu du tampon en un seul appel système
+ */
+static void	ft_out_drain(void)
+{
+	if (g_out.len)
+		write(1, g_out.buf, g_out.len);
+	g_out.len = 0;
+}
+
+/**
+ * @brief Gestionnaire de SIGALRM : vidage sur délai
+ * @param sig Signal reçu (non utilisé)
+ * 
+ * Si l'alarme interrompt une mise à jour du tampon (busy), le vidage
+ * est seulement noté dans late : ft_out_write_bonus l'effectuera en
+ * sortant, le tampon n'est jamais écrit dans un état intermédiaire.
+ */
+static void	ft_out_alarm(int sig)
+{
+	(void)sig;
+	if (g_out.busy)
+		g_out.late = 1;
+	else
+		ft_out_drain();
+}
+
+/**
+ * @brief Prépare le vidage sur délai et le vidage à la sortie du programme
+ * 
+ * Le minuteur n'est armé que lorsque le tampon passe de vide à non
+ * vide : un programme inactif ne reçoit aucune alarme. atexit() couvre
+ * tous les appels à exit(), y compris depuis un gestionnaire.
+ */
+void	ft_out_init_bonus(void)
+{
+	struct sigaction	sa;
+
+	g_out.timer.it_value.tv_sec = OUT_FLUSH_MS / 1000;
+	g_out.timer.it_value.tv_usec = OUT_FLUSH_MS % 1000 * 1000;
+	sa.sa_handler = ft_out_alarm;
+	sigfillset(&sa.sa_mask);
+	sa.sa_flags = SA_RESTART;
+	sigaction(SIGALRM, &sa, NULL);
+	atexit(ft_out_flush_bonus);
+}
+
+/**
+ * @brief Vide immédiatement le tampon de sortie
+ * 
+ * Appelée en fin de message et avant toute attente prolongée, pour que
+ * le texte reçu ne reste pas en mémoire.
+ */
+void	ft_out_flush_bonus(void)
+{
+	g_out.busy = 1;
+	g_out.late = 0;
+	ft_out_drain();
+	g_out.busy = 0;
+}
+
+/**
+ * @brief Ajoute des octets au tampon de sortie
+ * @param buf Octets à afficher
+ * @param len Nombre d'octets
+ * 
+ * Le tampon est vidé quand il déborde (seuil de taille) ; un bloc plus
+ * grand que le tampon est écrit directement, sans copie. Un appel
+ * imbriqué (gestionnaire interrompant un ajout) écrit lui aussi
+ * directement plutôt que de modifier le tampon en cours d'utilisation.
+ */
+void	ft_out_write_bonus(const char *buf, size_t len)
+{
+	if (g_out.busy)
+	{
+		write(1, buf, len);
+		return ;
+	}
+	g_out.busy = 1;
+	if (g_out.len + len > OUT_BUF_SIZE)
+		ft_out_drain();
+	if (len >= OUT_BUF_SIZE)
+	{
+		write(1, buf, len);
+		len = 0;
+	}
+	if (len && !g_out.len && OUT_FLUSH_MS > 0)
+		setitimer(ITIMER_REAL, &g_out.timer, NULL);
+	while (len--)
+		g_out.buf[g_out.len++] = *buf++;
+	g_out.busy = 0;
+	if (g_out.late)
+		ft_out_flush_bonus();
+}
@@ -6,7 +6,7 @@
 /*   By: fdi-tria <fdi-tria@student.42lausanne.c    +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/01/25 20:38:07 by fdi-tria          #+#    #+#             */
-/*   Updated: 2025/01/26 00:46:12 by fdi-tria         ###   ########.fr       */
+/*   Updated: 2026/10/16 16:12:30 by fdi-tria         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -17,134 +17,103 @@
 #include "bonus.h"
 
 /**
- * @brief Variable globale pour la synchronisation de la réception des données
+ * @brief Décode un signal retiré de la file, hors du gestionnaire
+ * @param ev Signal reçu : émetteur, numéro et valeur attachée
  * 
- * Cette variable volatile de type sig_atomic_t joue un rôle crucial dans
- * la synchronisation entre le gestionnaire de signaux et la boucle principale.
- * Son état indique si de nouvelles données ont été reçues et
- * doivent être traitées.
- * 
- * Caractéristiques importantes :
- * - volatile : Empêche l'optimisation qui masquerait les changements
- * - sig_atomic_t : Garantit des opérations atomiques
- * - Initialisation à 0 : État initial "pas de données en attente"
- */
-static volatile sig_atomic_t	g_data = 0;
-
-/**
- * @brief Gère le traitement d'un caractère complet et les statistiques associées
- * @param c           Caractère reconstruit à partir des bits reçus
- * @param client_pid  Pointeur vers le PID du client actif
- * @param i          Pointeur vers le compteur de bits du caractère en cours
- * @param stats      Pointeur vers la structure des statistiques de transmission
- * 
- * Cette fonction est appelée chaque fois qu'un caractère complet
- * (8 bits) est reçu.
- * Elle gère deux scénarios principaux :
+ * Cette fonction implémente un protocole sophistiqué de reconstruction
+ * des caractères à partir des signaux reçus. L'état de reconstruction
+ * n'est plus global : il vit dans la session du client émetteur,
+ * retrouvée par son PID (ev->pid) : les bits de plusieurs clients ne
+ * se mélangent pas. SIGUSR1 et SIGUSR2 ne sont toutefois pas mis en
+ * file ; un bit perdu entre deux clients est renvoyé par son client
+ * à l'échéance. Chaque bit porte son numéro dans les 16 bits de poids
+ * faible de ev->value : un numéro autre que bit_seq est un doublon,
+ * acquitté de nouveau sans être décodé. L'acquittement renvoie le
+ * numéro reçu. Un doublon qui ouvre une session arrive après la
+ * confirmation finale de son message : la session est refermée
+ * aussitôt, sans acquittement. Il en va de même dans tous les modes
+ * (mots, symboles, fenêtre glissante, sonnette de l'anneau partagé).
  * 
- * 1. Réception du caractère nul (fin de message) :
- *    - Affiche un saut de ligne
- *    - Imprime les statistiques finales
- *    - Envoie un signal de confirmation au client (SIGUSR2)
- *    - Réinitialise les compteurs pour la prochaine transmission
+ * Processus de reconstruction :
+ * 1. Recherche (ou création) de la session de l'émetteur
+ * 2. Vérification du numéro du bit, doublon écarté
+ * 3. Décalage à gauche du caractère en construction de la session
+ * 4. Ajout du nouveau bit (1 pour SIGUSR2, 0 pour SIGUSR1)
+ * 5. Mise à jour des statistiques
+ * 6. Traitement du caractère complet après 8 bits
+ * 7. Envoi de l'acquittement au client, ou libération de la session
+ *    si le message est terminé
  * 
- * 2. Réception d'un caractère normal :
- *    - Affiche le caractère
- *    - Met à jour le compteur de caractères
+ * En mode temps réel (SIGRTMIN + RT_WORD), le numéro est vérifié de
+ * la même façon, puis les étapes 3 à 6 sont remplacées par
+ * ft_receive_word_bonus qui lit 2 caractères dans la moitié haute de
+ * ev->value. En mode fenêtre glissante (SIGRTMIN + RT_SEQ),
+ * ft_receive_seq_bonus vérifie le numéro de séquence et envoie
+ * lui-même un acquittement cumulatif à la place de SIGUSR1. La
+ * sonnette de l'anneau partagé (SIGRTMIN + RT_DOORBELL) déclenche
+ * ft_shm_drain et n'est jamais acquittée. Au-delà de SIGRTMIN + RT_SYM,
+ * le numéro du signal est lui-même un symbole de l'alphabet négocié
+ * (-a) : après la même vérification du numéro, ft_receive_sym_bonus en
+ * tire plusieurs bits.
  * 
- * @note Cette fonction est critique pour maintenir la cohérence des statistiques
- *       et assurer une communication fiable avec le client.
+ * L'acquittement reste ici et non dans le gestionnaire : sa nature
+ * dépend du décodage (SIGUSR2 en fin de message, acquittement cumulatif
+ * en mode -w, aucun si la table des sessions est pleine), et le segment
+ * partagé de -m doit exister avant que le client ne reçoive le sien.
+ * Il passe par ft_sched_ack, qui le retient si le client a dépassé son
+ * débit (-R) ; la confirmation finale SIGUSR2 n'est jamais retenue.
  */
-static void	ft_handle_char_bonus(unsigned char c, pid_t *client_pid,
-				int *i, t_stats *stats)
+static void	ft_dispatch_bonus(const t_sigev *ev)
 {
-	*i = 0;
-	if (!c)
-	{
-		ft_putchar_bonus('\n');
-		ft_print_stats(stats);
-		kill(*client_pid, SIGUSR2);
-		stats->chars_received = 0;
-		stats->bits_received = 0;
-		*client_pid = 0;
+	t_session	*s;
+
+	s = ft_session_get(ev->pid);
+	if (!s)
 		return ;
+	ft_stats_tick(&s->stats, ev->time);
+	if (ev->sig == SIGRTMIN + RT_SEQ)
+		ft_receive_seq_bonus(ev->value, s);
+	else if (ev->sig == SIGRTMIN + RT_DOORBELL)
+		ft_shm_drain(s);
+	else if ((ev->value & 0xFFFF) == s->bit_seq)
+	{
+		s->bit_seq = (s->bit_seq + 1) & 0xFFFF;
+		if (ev->sig == SIGRTMIN + RT_WORD)
+			ft_receive_word_bonus((unsigned int)ev->value >> 16, s);
+		else if (ev->sig >= SIGRTMIN + RT_SYM)
+			ft_receive_sym_bonus(ev->sig - SIGRTMIN - RT_SYM, s);
+		else
+			ft_receive_bit_bonus(ev->sig, s);
 	}
-	ft_putchar_bonus(c);
-	stats->chars_received++;
+	else if (!s->stats.bits_received)
+		s->done = 1;
+	if (s->done)
+		ft_session_remove(s);
+	else if (ev->sig != SIGRTMIN + RT_SEQ
+		&& ev->sig != SIGRTMIN + RT_DOORBELL)
+		ft_sched_ack(s, SIGUSR1, ev->value);
 }
 
 /**
- * @brief Initialise une nouvelle session client avec affichage visuel
- * @param stats      Pointeur vers la structure des statistiques
- * @param client_pid PID du nouveau client connecté
- * 
- * Cette fonction assure un accueil visuel et informatif pour chaque
- * nouvelle connexion client. Elle :
- * 
- * 1. Enregistre le PID du nouveau client
- * 2. Affiche un message d'accueil formaté et coloré
- *    - Utilise une flèche distinctive (ARROW_MARK)
- *    - Affiche le PID du client en jaune
- *    - Réinitialise la couleur après l'affichage
- * 
- * L'utilisation des couleurs améliore la lisibilité et permet de
- * distinguer facilement les différents types d'événements dans les logs.
- */
-static void	ft_handle_new_client(t_stats *stats, pid_t client_pid)
-{
-	stats->client_pid = client_pid;
-	ft_putstr_bonus(COLOR_YELLOW);
-	ft_putstr_bonus(ARROW_MARK " Nouvelle connexion client (PID: ");
-	ft_putnbr_bonus(stats->client_pid);
-	ft_putstr_bonus(")\n");
-	ft_putstr_bonus(COLOR_RESET);
-}
-
-/**
- * @brief Gestionnaire principal des signaux avec reconstruction des caractères
- * @param sig      Signal reçu (SIGUSR1 ou SIGUSR2)
+ * @brief Gestionnaire de signaux du serveur : publie le signal et rend la main
+ * @param sig      Signal reçu (SIGUSR1, SIGUSR2 ou temps réel)
  * @param info     Structure contenant les informations du signal
  * @param context  Contexte d'exécution (non utilisé)
  * 
- * Cette fonction implémente un protocole sophistiqué de reconstruction
- * des caractères à partir des signaux reçus bit par bit. Elle maintient
- * plusieurs états persistants entre les appels :
- * 
- * - i : Position du bit en cours dans le caractère (0-7)
- * - c : Caractère en cours de reconstruction
- * - stats : Statistiques globales de la session
- * 
- * Processus de reconstruction :
- * 1. Détection d'un nouveau client si nécessaire
- * 2. Décalage à gauche du caractère en construction
- * 3. Ajout du nouveau bit (1 pour SIGUSR2, 0 pour SIGUSR1)
- * 4. Mise à jour des statistiques
- * 5. Traitement du caractère complet après 8 bits
- * 6. Envoi de l'acquittement au client
- * 
- * La fonction utilise g_data pour signaler à la boucle principale
- * qu'un nouveau bit a été reçu et traité.
+ * Le décodage, les statistiques et l'affichage demandent plusieurs
+ * appels système ; tant qu'ils s'exécutaient ici, les signaux du
+ * serveur restaient masqués d'autant, et un SIGUSR1 ou SIGUSR2 arrivé
+ * deux fois entre-temps n'était délivré qu'une fois. Le gestionnaire
+ * se limite désormais à copier
+ * (si_pid, numéro, valeur) dans la file SPSC, que la boucle principale
+ * décode avec ft_dispatch_bonus.
  */
 static void	ft_receive_bonus(int sig, siginfo_t *info, void *context)
 {
-	static int				i = 0;
-	static unsigned char	c = 0;
-	static t_stats			stats = {0, 0, 0, 0};
-
 	(void)context;
-	if (!stats.client_pid)
-		ft_handle_new_client(&stats, info->si_pid);
-	c = c << 1;
-	if (sig == SIGUSR2)
-		c = c | 1;
-	stats.bits_received++;
-	if (++i == 8)
-		ft_handle_char_bonus(c, &stats.client_pid, &i, &stats);
-	if (stats.client_pid)
-	{
-		kill(stats.client_pid, SIGUSR1);
-		g_data = 1;
-	}
+	ft_trace_rec_bonus(TRACE_RECV | sig, info->si_pid,
+		info->si_value.sival_int);
+	ft_sigq_push(info->si_pid, sig, info->si_value.sival_int);
 }
 
 /**
@@ -153,28 +122,87 @@ static void	ft_receive_bonus(int sig, siginfo_t *info, void *context)
  * @return 1 en cas de succès, 0 en cas d'échec
  * 
  * Cette fonction établit une configuration robuste pour le traitement
- * des signaux SIGUSR1 et SIGUSR2. Elle utilise sigaction pour une
- * gestion moderne et fiable des signaux avec les caractéristiques suivantes :
+ * des signaux SIGUSR1, SIGUSR2 et des signaux temps réel RT_WORD,
+ * RT_SEQ et RT_DOORBELL, puis de toute la plage SIGRTMIN + RT_SYM ..
+ * SIGRTMAX qui sert d'alphabet au mode -a.
+ * Elle utilise sigaction pour une gestion moderne et fiable des signaux
+ * avec les caractéristiques suivantes :
  * 
- * 1. Masque de signaux vide pour éviter le blocage
+ * 1. Tous ces signaux sont masqués pendant le handler (non réentrant)
  * 2. Handler avec informations étendues (SA_SIGINFO)
- * 3. Configuration identique pour les deux signaux
+ * 3. Configuration identique pour chaque signal
  * 
  * La configuration est vérifiée pour chaque signal avec gestion
  * d'erreur appropriée.
  */
 static int	ft_setup_signals(struct sigaction *sa)
 {
+	int	sig;
+
 	sigemptyset(&sa->sa_mask);
+	sigaddset(&sa->sa_mask, SIGUSR1);
+	sigaddset(&sa->sa_mask, SIGUSR2);
+	sigaddset(&sa->sa_mask, SIGRTMIN + RT_WORD);
+	sigaddset(&sa->sa_mask, SIGRTMIN + RT_SEQ);
+	sigaddset(&sa->sa_mask, SIGRTMIN + RT_DOORBELL);
+	sig = SIGRTMIN + RT_SYM;
+	while (sig <= SIGRTMAX)
+		sigaddset(&sa->sa_mask, sig++);
 	sa->sa_sigaction = ft_receive_bonus;
 	sa->sa_flags = SA_SIGINFO;
-	if (sigaction(SIGUSR1, sa, NULL) == -1)
-		return (0);
-	if (sigaction(SIGUSR2, sa, NULL) == -1)
+	if (sigaction(SIGUSR1, sa, NULL) == -1
+		|| sigaction(SIGUSR2, sa, NULL) == -1
+		|| sigaction(SIGRTMIN + RT_WORD, sa, NULL) == -1
+		|| sigaction(SIGRTMIN + RT_SEQ, sa, NULL) == -1
+		|| sigaction(SIGRTMIN + RT_DOORBELL, sa, NULL) == -1)
 		return (0);
+	sig = SIGRTMIN + RT_SYM;
+	while (sig <= SIGRTMAX)
+		if (sigaction(sig++, sa, NULL) == -1)
+			return (0);
 	return (1);
 }
 
+/**
+ * @brief Lit les limites de débit passées au lancement du serveur
+ * @param argc Nombre d'arguments
+ * @param argv Tableau des arguments
+ * @return 1 si toutes les options sont reconnues et valides, 0 sinon
+ * 
+ * Options disponibles, valeurs strictement positives :
+ * - -R N : débit maximal de chaque client en bits/s, au-delà duquel ses
+ *          acquittements sont retenus (par défaut : illimité)
+ * - -B N : rafale en bits tolérée avant toute retenue (SCHED_BURST)
+ * - -Q N : bits accordés à chaque client par tour du tourniquet
+ *          (SCHED_QUANTUM)
+ */
+static int	ft_parse_server(int argc, char **argv)
+{
+	t_sched_conf	*conf;
+	long			*field;
+	int				i;
+
+	conf = ft_sched_conf();
+	i = 1;
+	while (i + 1 < argc && argv[i][0] == '-' && argv[i][1] && !argv[i][2])
+	{
+		field = NULL;
+		if (argv[i][1] == 'R')
+			field = &conf->rate;
+		else if (argv[i][1] == 'B')
+			field = &conf->burst;
+		else if (argv[i][1] == 'Q')
+			field = &conf->quantum;
+		if (!field)
+			return (0);
+		*field = ft_atoi_bonus(argv[i + 1]);
+		if (*field <= 0)
+			return (0);
+		i += 2;
+	}
+	return (i == argc);
+}
+
 /**
  * @brief Point d'entrée du serveur Minitalk avec fonctionnalités avancées
  * 
@@ -186,9 +214,10 @@ static int	ft_setup_signals(struct sigaction *sa)
  *    - Messages de démarrage colorés
  * 
  * 2. Boucle de service :
- *    - Attente active économe (pause)
- *    - Traitement des données reçues
- *    - Réinitialisation du flag de données
+ *    - Attente sans perte de réveil (ft_sigq_wait), bornée par le
+ *      prochain acquittement retenu à libérer ou le prochain tour
+ *    - Décodage de tous les signaux en file, dans l'ordre d'arrivée
+ *    - Libération des acquittements retenus (ft_sched_run, option -R)
  * 
  * Le serveur utilise un système de couleurs pour améliorer la lisibilité :
  * - Vert : Messages de démarrage
@@ -196,13 +225,25 @@ static int	ft_setup_signals(struct sigaction *sa)
  * - Jaune : États d'attente
  * - Rouge : Messages d'erreur
  * 
+ * @param argc Nombre d'arguments
+ * @param argv Options -R, -B et -Q (voir ft_parse_server)
  * @return 0 en cas de succès, 1 en cas d'erreur d'initialisation
  */
-int	main(void)
+int	main(int argc, char **argv)
 {
 	struct sigaction		sa;
 	pid_t					pid;
+	t_sigev					ev;
+	long					wait;
 
+	ft_out_init_bonus();
+	ft_trace_init_bonus();
+	if (!ft_parse_server(argc, argv))
+	{
+		ft_print_colored(USAGE_SERVER, COLOR_RED);
+		ft_out_flush_bonus();
+		return (1);
+	}
 	pid = getpid();
 	ft_print_colored("🚀 Serveur Minitalk Bonus démarré", COLOR_GREEN);
 	ft_putstr_bonus(COLOR_BLUE);
@@ -210,17 +251,20 @@ int	main(void)
 	ft_putnbr_bonus(pid);
 	ft_putchar_bonus('\n');
 	ft_print_colored("En attente de messages...", COLOR_YELLOW);
+	ft_out_flush_bonus();
 	if (!ft_setup_signals(&sa))
 	{
 		ft_print_colored("Erreur: Configuration des signaux échouée",
 			COLOR_RED);
 		return (1);
 	}
+	wait = 0;
 	while (1)
 	{
-		while (!g_data)
-			pause();
-		g_data = 0;
+		ft_sigq_wait(wait);
+		while (ft_sigq_pop(&ev))
+			ft_dispatch_bonus(&ev);
+		wait = ft_sched_run();
 	}
 	return (0);
 }
@@ -0,0 +1,208 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   server_bonus_utils.c                               :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fdi-tria <fdi-tria@student.42lausanne.c    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 04:51:00 by fdi-tria          #+#    #+#             */
+/*   Updated: 2026/10/16 16:22:40 by fdi-tria         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "bonus.h"
+
+/**
+ * @brief Gère le traitement d'un caractère complet et les statistiques associées
+ * @param c Caractère reconstruit à partir des bits reçus
+ * @param s Session du client émetteur
+ * 
+ * Cette fonction est appelée chaque fois qu'un caractère complet
+ * (8 bits) est reçu pour une session. Le caractère nul termine le
+ * message ; en tête de message, un octet de contrôle (0xF8 à 0xFF)
+ * choisit le décodage des octets suivants ; tout autre caractère est
+ * du texte. En détail :
+ * 
+ * 1. Réception du caractère nul (fin de message) :
+ *    - Vide le tampon de la session puis affiche un saut de ligne
+ *    - Imprime les statistiques finales et vide le tampon de sortie
+ *    - Envoie un signal de confirmation au client (SIGUSR2)
+ *    - Marque la session comme terminée ; c'est l'appelant qui la
+ *      retire de la table une fois le signal entièrement traité
+ * 
+ * 2. Octet CTL_SHM en tête de message (option -m du client) :
+ *    - Crée l'anneau partagé du client, l'octet n'est pas affiché
+ * 
+ * 3. Octet CTL_LZ en tête de message (option -z du client) :
+ *    - Active le décodeur LZ : les octets suivants sont confiés à
+ *      ft_lz_feed, qui rappelle cette fonction avec '\0' en fin de flux
+ * 
+ * 4. Octet CTL_HUF en tête de message (option -H du client) :
+ *    - Les bits suivants sont décodés un à un par ft_huff_bit
+ * 
+ * 5. Octet CTL_FRAME en tête de message (option -l du client) :
+ *    - Les octets suivants forment une trame à longueur préfixée,
+ *      confiée à ft_frame_feed ; '\0' n'y termine plus le message
+ * 
+ * 6. Octet CTL_SYM en tête de message (option -a du client) :
+ *    - L'octet suivant est la taille d'alphabet proposée, confiée à
+ *      ft_sym_accept ; le texte arrive ensuite par symboles. Une
+ *      proposition invalide n'obtient pas de réponse et l'octet est
+ *      traité comme du texte
+ * 
+ * 7. Octet CTL_LANE en tête de message (option -j du client) :
+ *    - Le processus est une voie d'un transfert parallèle : son
+ *      morceau est confié à ft_lane_feed, qui le range dans le groupe
+ *      du client parent
+ * 
+ * 8. Octet CTL_ESC en tête de message :
+ *    - Retiré sans effet : le message en clair commence par un octet
+ *      réservé, que le test de tête ne voit plus et qui est affiché
+ * 
+ * 9. Réception d'un caractère normal :
+ *    - Ajoute le caractère au tampon de la session
+ *    - Met à jour le compteur de caractères
+ * 
+ * @note Le texte d'un client est affiché par blocs de SESSION_BUF
+ *       octets : deux messages simultanés ne s'entrelacent plus
+ *       caractère par caractère sur la sortie.
+ */
+void	ft_handle_char_bonus(unsigned char c, t_session *s)
+{
+	s->bit_count = 0;
+	if (s->sym_state == SYM_PROPOSE && ft_sym_accept(c, s))
+		return ;
+	if (s->lz.state != LZ_IDLE || s->frame.state != FRAME_IDLE
+		|| s->lane.state != LANE_IDLE)
+	{
+		if (s->lz.state != LZ_IDLE)
+			ft_lz_feed(c, s);
+		else if (s->frame.state != FRAME_IDLE)
+			ft_frame_feed(c, s);
+		else
+			ft_lane_feed(c, s);
+		return ;
+	}
+	if (s->msg_bytes++ == 0 && c >= CTL_SYM
+		&& (c <= CTL_LANE || c == CTL_ESC))
+	{
+		if (c == CTL_SHM)
+			ft_shm_attach(s);
+		else if (c == CTL_LZ)
+			ft_lz_start(s);
+		else if (c == CTL_HUF)
+			ft_huff_start(s);
+		else if (c == CTL_SYM)
+			ft_sym_start(s);
+		else if (c == CTL_FRAME)
+			ft_frame_start(s);
+		else if (c == CTL_LANE)
+			ft_lane_start(s);
+		return ;
+	}
+	if (!c)
+	{
+		ft_session_flush(s);
+		ft_putchar_bonus('\n');
+		ft_print_stats(&s->stats);
+		ft_out_flush_bonus();
+		ft_trace_rec_bonus(TRACE_ACK | SIGUSR2, s->pid, 0);
+		kill(s->pid, SIGUSR2);
+		s->done = 1;
+		return ;
+	}
+	s->out[s->out_len++] = c;
+	s->stats.chars_received++;
+	if (s->out_len == SESSION_BUF)
+		ft_session_flush(s);
+}
+
+/**
+ * @brief Annonce une nouvelle session client avec affichage visuel
+ * @param s Session qui vient d'être créée pour ce client
+ * 
+ * Cette fonction assure un accueil visuel et informatif pour chaque
+ * nouvelle connexion client. Elle affiche un message d'accueil
+ * formaté et coloré :
+ * - Utilise une flèche distinctive (ARROW_MARK)
+ * - Affiche le PID du client en jaune
+ * - Réinitialise la couleur après l'affichage
+ * 
+ * L'utilisation des couleurs améliore la lisibilité et permet de
+ * distinguer facilement les différents types d'événements dans les logs.
+ */
+void	ft_handle_new_client(t_session *s)
+{
+	ft_putstr_bonus(COLOR_YELLOW);
+	ft_putstr_bonus(ARROW_MARK " Nouvelle connexion client (PID: ");
+	ft_putnbr_bonus(s->pid);
+	ft_putstr_bonus(")\n");
+	ft_putstr_bonus(COLOR_RESET);
+}
+
+/**
+ * @brief Ajoute un bit au caractère en reconstruction d'une session
+ * @param sig SIGUSR2 pour un bit à 1, SIGUSR1 pour un bit à 0
+ * @param s   Session du client émetteur
+ * 
+ * Les bits arrivent poids fort d'abord : le caractère est décalé à
+ * gauche avant l'ajout du nouveau bit, puis transmis à
+ * ft_handle_char_bonus dès que 8 bits ont été reçus. En mode Huffman
+ * (-H), les caractères n'ont plus de taille fixe : chaque bit part
+ * directement au décodeur.
+ */
+void	ft_receive_bit_bonus(int sig, t_session *s)
+{
+	if (s->huff.state != HUF_IDLE)
+	{
+		s->stats.bits_received++;
+		ft_huff_bit(sig == SIGUSR2, s);
+		return ;
+	}
+	s->c = s->c << 1;
+	if (sig == SIGUSR2)
+		s->c = s->c | 1;
+	s->stats.bits_received++;
+	if (++s->bit_count == 8)
+		ft_handle_char_bonus(s->c, s);
+}
+
+/**
+ * @brief Traite un mot de 16 bits reçu en mode temps réel
+ * @param word Moitié haute de sigval.sival_int, la basse portant le numéro
+ * @param s    Session du client émetteur
+ * 
+ * Le mot transporte jusqu'à 2 caractères, le premier dans les bits de
+ * poids fort. Les 16 bits sont comptabilisés avant le découpage pour que
+ * les statistiques affichées à la fin du message soient complètes.
+ * 
+ * Chaque octet passe ensuite par ft_handle_char_bonus comme s'il avait
+ * été reconstruit bit par bit. Dès que le '\0' terminal est traité,
+ * la session est terminée et l'octet de bourrage restant est ignoré.
+ */
+void	ft_receive_word_bonus(unsigned int word, t_session *s)
+{
+	int	shift;
+
+	s->stats.bits_received += 16;
+	shift = 8;
+	while (shift >= 0 && !s->done)
+	{
+		ft_handle_char_bonus((word >> shift) & 0xFF, s);
+		shift -= 8;
+	}
+}
+
+/**
+ * @brief Affiche le texte accumulé par une session
+ * @param s Session dont le tampon doit être vidé
+ * 
+ * Le bloc est ajouté d'un seul tenant au tampon de sortie : appelé
+ * par la seule boucle principale, il ne peut pas être coupé par la
+ * sortie d'un autre client.
+ */
+void	ft_session_flush(t_session *s)
+{
+	ft_out_write_bonus(s->out, s->out_len);
+	s->out_len = 0;
+}
@@ -0,0 +1,167 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   server_frame_bonus.c                               :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fdi-tria <fdi-tria@student.42lausanne.c    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 05:55:31 by fdi-tria          #+#    #+#             */
+/*   Updated: 2026/10/16 14:40:02 by fdi-tria         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/* Définition des standards POSIX pour mmap() et MAP_ANONYMOUS */
+#define _POSIX_C_SOURCE 199309L
+#define _XOPEN_SOURCE 700
+#define _DEFAULT_SOURCE
+#include "bonus.h"
+#include <sys/mman.h>
+
+/**
+ * @brief Prépare la réception d'une trame après l'octet CTL_FRAME
+ * @param s Session du client émetteur
+ */
+void	ft_frame_start(t_session *s)
+{
+	s->frame.state = FRAME_LEN;
+	s->frame.shift = 0;
+	s->frame.flags = 0;
+	s->frame.len = 0;
+	s->frame.got = 0;
+	s->frame.buf = NULL;
+	s->frame.seps = 0;
+}
+
+/**
+ * @brief Termine la trame : affichage d'un bloc puis fin de message
+ * @param s  Session du client émetteur
+ * @param ok 0 si l'en-tête de la trame est invalide
+ *
+ * Le contenu réservé part en un seul appel à ft_out_write_bonus, qui
+ * l'écrit directement s'il dépasse le tampon de sortie. Une trame
+ * marquée FRAME_F_MORE ou FRAME_F_NEXT laisse le message ouvert : la
+ * réception reprend à la taille de la trame suivante, sans nouvelle
+ * session ni nouvelle confirmation. Sinon, le '\0' confié à
+ * ft_handle_char_bonus n'est qu'un marqueur de fin : il affiche les
+ * statistiques et envoie la confirmation finale.
+ */
+static void	ft_frame_end(t_session *s, int ok)
+{
+	ft_session_flush(s);
+	if (s->frame.buf)
+		ft_out_write_bonus((const char *)s->frame.buf, s->frame.got);
+	ft_frame_release(s);
+	if (ok && (s->frame.flags & (FRAME_F_MORE | FRAME_F_NEXT)))
+	{
+		s->frame.seps += ((s->frame.flags & FRAME_F_NEXT) != 0);
+		s->frame.state = FRAME_LEN;
+		s->frame.shift = 0;
+		s->frame.len = 0;
+		s->frame.got = 0;
+		return ;
+	}
+	while (s->frame.seps > 1)
+	{
+		ft_putchar_bonus('\n');
+		s->frame.seps--;
+	}
+	s->frame.state = FRAME_IDLE;
+	if (!ok)
+		ft_putstr_bonus("\n" COLOR_RED CROSS_MARK "Trame invalide"
+			COLOR_RESET);
+	ft_handle_char_bonus('\0', s);
+}
+
+/**
+ * @brief Réserve le tampon de la trame une fois sa taille connue
+ * @param s Session du client émetteur
+ *
+ * mmap() anonyme, rendu au système dès la fin de la trame : la
+ * réservation a lieu une seule fois par trame, à la taille exacte.
+ * En cas d'échec, le contenu passe par le tampon de session par blocs
+ * de SESSION_BUF, comme un texte en clair.
+ *
+ * Les fins d'enregistrement (FRAME_F_NEXT) ne sont écrites qu'ici,
+ * devant le contenu qui les suit : la fin de message ajoute déjà son
+ * propre saut de ligne, qui tient lieu de dernière fin d'enregistrement.
+ */
+static void	ft_frame_reserve(t_session *s)
+{
+	void	*map;
+
+	while (s->frame.seps)
+	{
+		ft_putchar_bonus('\n');
+		s->frame.seps--;
+	}
+	map = mmap(NULL, s->frame.len, PROT_READ | PROT_WRITE,
+			MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (map != MAP_FAILED)
+		s->frame.buf = map;
+}
+
+/**
+ * @brief Fait avancer la réception d'une trame d'un octet
+ * @param c Octet reçu après CTL_FRAME
+ * @param s Session du client émetteur
+ *
+ * 1. Taille en varint : au plus FRAME_VARINT_MAX octets, plafonnée à
+ *    FRAME_MAX_LEN pour qu'un client ne puisse pas réserver n'importe quoi
+ * 2. Drapeaux : tout bit hors de FRAME_FLAGS_KNOWN invalide la trame
+ * 3. Contenu : copié tel quel, y compris '\0' et octets de contrôle ;
+ *    la trame se termine au len-ième octet, le message avec la première
+ *    trame sans FRAME_F_MORE ni FRAME_F_NEXT
+ */
+void	ft_frame_feed(unsigned char c, t_session *s)
+{
+	t_frame	*f;
+	int		ok;
+
+	f = &s->frame;
+	ok = 1;
+	if (f->state == FRAME_DATA)
+	{
+		if (f->buf)
+			f->buf[f->got] = c;
+		else
+			s->out[s->out_len++] = c;
+		f->got++;
+		s->stats.chars_received++;
+		if (!f->buf && s->out_len == SESSION_BUF)
+			ft_session_flush(s);
+	}
+	else if (f->state == FRAME_LEN)
+	{
+		f->len |= (size_t)(c & 0x7F) << f->shift;
+		f->shift += 7;
+		ok = (f->len <= FRAME_MAX_LEN
+				&& (!(c & 0x80) || f->shift < 7 * FRAME_VARINT_MAX));
+		if (!(c & 0x80))
+			f->state = FRAME_FLAGS;
+	}
+	else
+	{
+		f->flags = c;
+		ok = !(c & ~FRAME_FLAGS_KNOWN);
+		f->state = FRAME_DATA;
+		if (ok && f->len)
+			ft_frame_reserve(s);
+	}
+	if (!ok || (f->state == FRAME_DATA && f->got == f->len))
+		ft_frame_end(s, ok);
+}
+
+/**
+ * @brief Libère le tampon réservé d'une trame
+ * @param s Session dont la trame est terminée ou abandonnée
+ *
+ * Appelée en fin de trame et au retrait de la session, pour qu'un
+ * client interrompu ne laisse pas sa réservation derrière lui.
+ */
+void	ft_frame_release(t_session *s)
+{
+	if (!s->frame.buf)
+		return ;
+	munmap(s->frame.buf, s->frame.len);
+	s->frame.buf = NULL;
+}
@@ -0,0 +1,159 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   server_huff_bonus.c                                :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fdi-tria <fdi-tria@student.42lausanne.c    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 05:36:52 by fdi-tria          #+#    #+#             */
+/*   Updated: 2026/10/16 09:51:20 by fdi-tria         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "bonus.h"
+
+/**
+ * @brief Bascule une session en réception Huffman après l'octet CTL_HUF
+ * @param s Session du client émetteur
+ *
+ * Les bits suivants ne sont plus regroupés par 8 : ft_receive_bit_bonus
+ * les confie un à un à ft_huff_bit jusqu'au '\0' terminal.
+ */
+void	ft_huff_start(t_session *s)
+{
+	int	i;
+
+	s->huff.state = HUF_COUNT;
+	s->huff.got = 0;
+	s->huff.field = 0;
+	s->huff.field_bits = 0;
+	s->huff.len = 0;
+	i = 0;
+	while (i <= HUF_MAX_LEN)
+		s->huff.count[i++] = 0;
+}
+
+/**
+ * @brief Abandonne un flux Huffman incohérent
+ * @param s Session du client émetteur
+ *
+ * Comme pour le mode compressé, l'erreur est signalée puis le message
+ * est clos par un '\0' : le client reçoit sa confirmation finale.
+ */
+static void	ft_huff_fail(t_session *s)
+{
+	s->huff.state = HUF_IDLE;
+	ft_session_flush(s);
+	ft_putstr_bonus("\n" COLOR_RED CROSS_MARK "Flux Huffman invalide"
+		COLOR_RESET);
+	ft_handle_char_bonus('\0', s);
+}
+
+/**
+ * @brief Enregistre une entrée [symbole | longueur] de l'en-tête
+ * @param s Session du client émetteur
+ * @return 0 si la longueur est hors limites ou l'ordre non canonique
+ *
+ * Les entrées arrivent triées par longueur puis par symbole : il suffit
+ * de les ranger à la suite et de compter les codes de chaque longueur
+ * pour obtenir les tables du décodage canonique.
+ */
+static int	ft_huff_entry(t_session *s)
+{
+	t_huff	*h;
+	int		sym;
+	int		len;
+
+	h = &s->huff;
+	sym = h->field >> 4;
+	len = h->field & 0xF;
+	h->field = 0;
+	h->field_bits = 0;
+	if (!len || len < h->len
+		|| (len == h->len && h->got && sym <= h->symbol[h->got - 1]))
+		return (0);
+	h->len = len;
+	h->count[len]++;
+	h->symbol[h->got++] = sym;
+	if (h->got == h->nsym)
+	{
+		h->state = HUF_DATA;
+		h->code = 0;
+		h->first = 0;
+		h->index = 0;
+		h->len = 1;
+	}
+	return (1);
+}
+
+/**
+ * @brief Prolonge le code en cours d'un bit et émet le symbole trouvé
+ * @param bit Bit reçu
+ * @param s   Session du client émetteur
+ * @return 0 si aucun code de HUF_MAX_LEN bits au plus ne correspond
+ *
+ * Les codes canoniques d'une même longueur sont consécutifs : code est
+ * un code de cette longueur dès que code - first < count[len]. Sinon
+ * les compteurs passent à la longueur suivante. Le symbole décodé suit
+ * le chemin d'un caractère reçu en clair, '\0' final compris.
+ */
+static int	ft_huff_data(int bit, t_session *s)
+{
+	t_huff			*h;
+	unsigned char	sym;
+
+	h = &s->huff;
+	h->code |= bit;
+	if (h->code - h->first < h->count[h->len])
+	{
+		sym = h->symbol[h->index + h->code - h->first];
+		h->code = 0;
+		h->first = 0;
+		h->index = 0;
+		h->len = 1;
+		if (!sym)
+			h->state = HUF_IDLE;
+		ft_handle_char_bonus(sym, s);
+		return (1);
+	}
+	h->index += h->count[h->len];
+	h->first = (h->first + h->count[h->len]) << 1;
+	h->code <<= 1;
+	return (++h->len <= HUF_MAX_LEN);
+}
+
+/**
+ * @brief Traite un bit reçu en mode Huffman
+ * @param bit Valeur du bit (1 pour SIGUSR2)
+ * @param s   Session du client émetteur
+ *
+ * Remplace la frontière fixe de 8 bits : l'en-tête est lu champ par
+ * champ (8 bits de nombre de symboles, puis HUF_ENTRY_BITS par entrée)
+ * et chaque bit du texte coûte quelques comparaisons, sans allocation.
+ */
+void	ft_huff_bit(int bit, t_session *s)
+{
+	t_huff	*h;
+	int		ok;
+
+	h = &s->huff;
+	if (h->state == HUF_DATA)
+		ok = ft_huff_data(bit, s);
+	else
+	{
+		h->field = (h->field << 1) | bit;
+		h->field_bits++;
+		ok = 1;
+		if (h->state == HUF_COUNT && h->field_bits == 8)
+		{
+			h->nsym = h->field + 1;
+			h->state = HUF_ENTRY;
+			h->field = 0;
+			h->field_bits = 0;
+		}
+		else if (h->state == HUF_ENTRY && h->field_bits == HUF_ENTRY_BITS)
+			ok = ft_huff_entry(s);
+	}
+	if (!ok)
+		ft_huff_fail(s);
+}
@@ -0,0 +1,129 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   server_lane_bonus.c                                :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fdi-tria <fdi-tria@student.42lausanne.c    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 08:47:53 by fdi-tria          #+#    #+#             */
+/*   Updated: 2026/10/16 14:21:12 by fdi-tria         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/* Définition des standards POSIX pour mmap() et MAP_ANONYMOUS */
+#define _POSIX_C_SOURCE 199309L
+#define _XOPEN_SOURCE 700
+#define _DEFAULT_SOURCE
+#include "bonus.h"
+#include <sys/mman.h>
+
+/**
+ * @brief Prépare la réception d'une voie après l'octet CTL_LANE
+ * @param s Session du processus de la voie
+ */
+void	ft_lane_start(t_session *s)
+{
+	s->lane.state = LANE_HEAD;
+	s->lane.head_len = 0;
+	s->lane.group = NULL;
+}
+
+/**
+ * @brief Interprète l'en-tête d'une voie et réserve son morceau
+ * @param s Session du processus de la voie
+ *
+ * Une voie hors limites, déjà reçue, ou dont le groupe ne peut pas
+ * être trouvé est rejetée : ses octets sont lus puis ignorés, pour que
+ * la suite du flux ne soit pas prise pour un nouveau message. Comme
+ * pour une trame, le morceau est réservé par mmap() à sa taille exacte ;
+ * en cas d'échec, le groupe est marqué et le message sera signalé
+ * comme perdu au lieu d'être affiché incomplet.
+ */
+static void	ft_lane_head(t_session *s)
+{
+	const unsigned char	*h;
+	t_lanes				*g;
+	void				*map;
+
+	h = s->lane.head;
+	s->lane.idx = h[4];
+	s->lane.len = (size_t)h[6] << 24 | h[7] << 16 | h[8] << 8 | h[9];
+	s->lane.got = 0;
+	s->lane.state = LANE_DATA;
+	g = NULL;
+	if (h[5] >= 1 && h[5] <= LANE_MAX && s->lane.idx < h[5])
+		g = ft_lanes_get(h[0] << 24 | h[1] << 16 | h[2] << 8 | h[3], h[5]);
+	if (g && (g->seen & (1 << s->lane.idx)))
+		g = NULL;
+	s->lane.group = g;
+	if (!g)
+		return ;
+	g->seen |= 1 << s->lane.idx;
+	g->len[s->lane.idx] = s->lane.len;
+	g->buf[s->lane.idx] = NULL;
+	if (!s->lane.len)
+		return ;
+	map = mmap(NULL, s->lane.len, PROT_READ | PROT_WRITE,
+			MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (map == MAP_FAILED)
+		g->failed = 1;
+	else
+		g->buf[s->lane.idx] = map;
+}
+
+/**
+ * @brief Termine une voie dont tout le morceau est reçu
+ * @param s Session du processus de la voie
+ *
+ * Le processus de la voie reçoit sa propre confirmation (SIGUSR2) et
+ * sa session est libérée. La dernière voie du groupe déclenche
+ * l'affichage du message complet et la confirmation du client parent.
+ */
+static void	ft_lane_end(t_session *s)
+{
+	t_lanes	*g;
+
+	g = s->lane.group;
+	s->lane.state = LANE_IDLE;
+	ft_trace_rec_bonus(TRACE_ACK | SIGUSR2, s->pid, 0);
+	kill(s->pid, SIGUSR2);
+	s->done = 1;
+	if (!g)
+	{
+		ft_putstr_bonus(COLOR_RED CROSS_MARK "Voie invalide\n" COLOR_RESET);
+		return ;
+	}
+	ft_stats_merge(&g->stats, &s->stats);
+	if (++g->done == g->count)
+		ft_lanes_emit(g);
+}
+
+/**
+ * @brief Fait avancer la réception d'une voie d'un octet
+ * @param c Octet reçu après CTL_LANE
+ * @param s Session du processus de la voie
+ *
+ * Les LANE_HEADER premiers octets forment l'en-tête ; les suivants sont
+ * copiés dans l'emplacement de la voie, au rang où ils arrivent. La
+ * voie se termine à son len-ième octet, sans '\0' terminal.
+ */
+void	ft_lane_feed(unsigned char c, t_session *s)
+{
+	t_lanes	*g;
+
+	g = s->lane.group;
+	if (s->lane.state == LANE_HEAD)
+	{
+		s->lane.head[s->lane.head_len++] = c;
+		if (s->lane.head_len == LANE_HEADER)
+			ft_lane_head(s);
+	}
+	else
+	{
+		if (g && g->buf[s->lane.idx])
+			g->buf[s->lane.idx][s->lane.got] = c;
+		s->lane.got++;
+	}
+	if (s->lane.state == LANE_DATA && s->lane.got == s->lane.len)
+		ft_lane_end(s);
+}
@@ -0,0 +1,108 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   server_lanes_bonus.c                               :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fdi-tria <fdi-tria@student.42lausanne.c    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 08:41:27 by fdi-tria          #+#    #+#             */
+/*   Updated: 2026/10/16 14:21:12 by fdi-tria         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/* Définition des standards POSIX pour munmap() */
+#define _POSIX_C_SOURCE 199309L
+#define _XOPEN_SOURCE 700
+#define _DEFAULT_SOURCE
+#include "bonus.h"
+#include <sys/mman.h>
+
+/**
+ * @brief Accès à la table des groupes de voies
+ * @return Tableau de LANE_GROUPS groupes, libres au démarrage
+ *
+ * Statique comme la table des sessions : capacité fixe, aucune
+ * allocation pendant la réception.
+ */
+static t_lanes	*ft_lanes_table(void)
+{
+	static t_lanes	table[LANE_GROUPS];
+
+	return (table);
+}
+
+/**
+ * @brief Retrouve le groupe d'un client parent, ou le crée
+ * @param owner PID du client parent, annoncé dans l'en-tête de la voie
+ * @param count Nombre de voies annoncé
+ * @return Le groupe, ou NULL si le nombre de voies ne correspond pas à
+ *         celui du groupe existant ou si la table est pleine
+ *
+ * La première voie arrivée crée le groupe, quel que soit son numéro :
+ * les voies partent en même temps et le noyau ne garantit aucun ordre
+ * entre processus.
+ */
+t_lanes	*ft_lanes_get(pid_t owner, int count)
+{
+	t_lanes	*table;
+	t_lanes	*free_slot;
+	int		i;
+
+	table = ft_lanes_table();
+	free_slot = NULL;
+	i = -1;
+	while (++i < LANE_GROUPS)
+	{
+		if (table[i].owner == owner)
+		{
+			if (table[i].count != count)
+				return (NULL);
+			return (&table[i]);
+		}
+		if (!table[i].owner && !free_slot)
+			free_slot = &table[i];
+	}
+	if (!free_slot)
+		return (NULL);
+	free_slot->owner = owner;
+	free_slot->count = count;
+	free_slot->done = 0;
+	free_slot->seen = 0;
+	free_slot->failed = 0;
+	ft_stats_reset(&free_slot->stats, owner);
+	return (free_slot);
+}
+
+/**
+ * @brief Affiche un message complet, morceaux remis dans l'ordre
+ * @param g Groupe dont toutes les voies sont reçues
+ *
+ * Chaque morceau part d'un seul bloc vers le tampon de sortie puis est
+ * libéré. La confirmation finale va au client parent, qui attend la
+ * fin de toutes ses voies ; le groupe est ensuite rendu libre.
+ */
+void	ft_lanes_emit(t_lanes *g)
+{
+	int	i;
+
+	i = -1;
+	while (++i < g->count)
+	{
+		if (g->buf[i] && !g->failed)
+			ft_out_write_bonus((const char *)g->buf[i], g->len[i]);
+		if (!g->failed)
+			g->stats.chars_received += g->len[i];
+		if (g->buf[i])
+			munmap(g->buf[i], g->len[i]);
+		g->buf[i] = NULL;
+	}
+	if (g->failed)
+		ft_putstr_bonus(COLOR_RED CROSS_MARK "Mémoire insuffisante pour le "
+			"message" COLOR_RESET);
+	ft_putchar_bonus('\n');
+	ft_print_stats(&g->stats);
+	ft_out_flush_bonus();
+	ft_trace_rec_bonus(TRACE_ACK | SIGUSR2, g->owner, 0);
+	kill(g->owner, SIGUSR2);
+	g->owner = 0;
+}
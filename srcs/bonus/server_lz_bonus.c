@@ -0,0 +1,157 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   server_lz_bonus.c                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fdi-tria <fdi-tria@student.42lausanne.c    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 05:21:08 by fdi-tria          #+#    #+#             */
+/*   Updated: 2026/10/16 09:51:20 by fdi-tria         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "bonus.h"
+
+/**
+ * @brief Prépare le décodeur d'une session après l'octet CTL_LZ
+ * @param s Session du client émetteur
+ *
+ * Les LZ_HEADER octets suivants forment l'en-tête ; le flux compressé
+ * ne commence qu'ensuite.
+ */
+void	ft_lz_start(t_session *s)
+{
+	s->lz.state = LZ_HEAD;
+	s->lz.head_len = 0;
+	s->lz.raw_len = 0;
+	s->lz.left = 0;
+	s->lz.pos = 0;
+}
+
+/**
+ * @brief Ajoute un octet décodé au texte de la session
+ * @param c Octet produit par le décodeur
+ * @param s Session du client émetteur
+ *
+ * L'octet est conservé dans la fenêtre pour les copies suivantes, puis
+ * suit le même chemin qu'un caractère reçu en clair.
+ */
+static void	ft_lz_emit(unsigned char c, t_session *s)
+{
+	s->lz.hist[s->lz.pos++ & (LZ_WINDOW - 1)] = c;
+	s->out[s->out_len++] = c;
+	s->stats.chars_received++;
+	if (s->out_len == SESSION_BUF)
+		ft_session_flush(s);
+}
+
+/**
+ * @brief Copie un motif déjà décodé à la fin du texte
+ * @param c Octet de poids faible du décalage
+ * @param s Session du client émetteur
+ * @return 0 si le décalage sort de la fenêtre ou du texte produit
+ *
+ * Source et destination peuvent se chevaucher (décalage inférieur à la
+ * longueur) : la copie octet par octet répète alors le motif, comme
+ * l'encodeur l'a supposé.
+ */
+static int	ft_lz_copy(unsigned char c, t_session *s)
+{
+	t_lz	*z;
+
+	z = &s->lz;
+	z->offset |= c;
+	if (!z->offset || z->offset > z->pos || z->offset > LZ_WINDOW)
+		return (0);
+	while (z->count--)
+		ft_lz_emit(z->hist[(z->pos - z->offset) & (LZ_WINDOW - 1)], s);
+	z->state = LZ_TOKEN;
+	return (1);
+}
+
+/**
+ * @brief Interprète un octet du flux compressé selon l'étape courante
+ * @param c Octet reçu
+ * @param s Session du client émetteur
+ * @return 0 si le flux est invalide, 1 sinon
+ *
+ * Un jeton annonce soit des littéraux, recopiés tels quels, soit une
+ * copie dont le décalage suit sur deux octets, poids fort d'abord.
+ */
+static int	ft_lz_step(unsigned char c, t_session *s)
+{
+	t_lz	*z;
+
+	z = &s->lz;
+	if (z->state == LZ_OFF_LO)
+		return (ft_lz_copy(c, s));
+	if (z->state == LZ_OFF_HI)
+	{
+		z->offset = (unsigned int)c << 8;
+		z->state = LZ_OFF_LO;
+	}
+	else if (z->state == LZ_LIT)
+	{
+		ft_lz_emit(c, s);
+		if (--z->count == 0)
+			z->state = LZ_TOKEN;
+	}
+	else if (c & 0x80)
+	{
+		z->count = (c & 0x7F) + LZ_MIN_MATCH;
+		z->state = LZ_OFF_HI;
+	}
+	else
+	{
+		z->count = c + 1;
+		z->state = LZ_LIT;
+	}
+	return (1);
+}
+
+/**
+ * @brief Fait avancer le décodeur LZ d'un octet reçu
+ * @param c Octet reçu après CTL_LZ
+ * @param s Session du client émetteur
+ *
+ * Appelée par ft_handle_char_bonus pour chaque octet : un octet coûte
+ * au plus une copie de LZ_MAX_MATCH octets depuis la
+ * fenêtre, sans allocation. L'en-tête [codec | taille brute | taille
+ * compressée] est lu poids fort d'abord ; le message se termine quand
+ * la taille compressée annoncée est atteinte.
+ *
+ * Un flux incohérent (codec inconnu, décalage hors du texte, taille
+ * finale différente de celle annoncée) est signalé mais clôt tout de
+ * même la session, pour que le client ne patiente pas indéfiniment.
+ */
+void	ft_lz_feed(unsigned char c, t_session *s)
+{
+	t_lz	*z;
+	int		ok;
+
+	z = &s->lz;
+	ok = 1;
+	if (z->state != LZ_HEAD)
+	{
+		ok = ft_lz_step(c, s);
+		z->left--;
+	}
+	else if (z->head_len++ == 0)
+		ok = (c == LZ_CODEC);
+	else if (z->head_len <= 5)
+		z->raw_len = (z->raw_len << 8) | c;
+	else
+		z->left = (z->left << 8) | c;
+	if (z->state == LZ_HEAD && z->head_len == LZ_HEADER)
+		z->state = LZ_TOKEN;
+	if (ok && (z->state == LZ_HEAD || z->left))
+		return ;
+	z->state = LZ_IDLE;
+	if (!ok || z->pos != z->raw_len)
+	{
+		ft_session_flush(s);
+		ft_putstr_bonus("\n" COLOR_RED CROSS_MARK "Flux compressé invalide"
+			COLOR_RESET);
+	}
+	ft_handle_char_bonus('\0', s);
+}
@@ -0,0 +1,135 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   server_queue_bonus.c                               :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fdi-tria <fdi-tria@student.42lausanne.c    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 09:18:44 by fdi-tria          #+#    #+#             */
+/*   Updated: 2026/10/16 14:42:10 by fdi-tria         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/* Définition des standards POSIX pour syscall() */
+#define _POSIX_C_SOURCE 199309L
+#define _XOPEN_SOURCE 700
+#define _DEFAULT_SOURCE
+#include "bonus.h"
+#include <linux/futex.h>
+#include <sys/syscall.h>
+
+/**
+ * @brief Accès à la file des signaux reçus
+ * @return La file, vide au démarrage
+ *
+ * Statique et préallouée : le gestionnaire n'alloue rien, et les pages
+ * de ev[] ne sont touchées qu'à mesure que la file se remplit.
+ */
+static t_sigq	*ft_sigq(void)
+{
+	static t_sigq	queue;
+
+	return (&queue);
+}
+
+/**
+ * @brief Publie un signal dans la file (côté gestionnaire)
+ * @param pid   Émetteur du signal
+ * @param sig   Numéro du signal
+ * @param value Valeur attachée, sans objet pour SIGUSR1 et SIGUSR2
+ *
+ * Seul producteur : une lecture de head, quatre écritures et une
+ * publication de tail avec la sémantique release, pour que la boucle
+ * principale ne voie jamais une entrée à moitié écrite. L'instant
+ * d'arrivée est relevé ici (clock_gettime est async-signal-safe) : lu
+ * au décodage, il dépendrait de la taille des lots vidés par la
+ * boucle. Chaque client attend l'acquittement de ses unités en vol
+ * avant d'en envoyer d'autres : la file ne peut déborder que si leur
+ * somme dépasse SIGQ_SIZE. Le signal est alors compté comme perdu.
+ */
+void	ft_sigq_push(pid_t pid, int sig, int value)
+{
+	t_sigq			*q;
+	unsigned int	tail;
+
+	q = ft_sigq();
+	tail = atomic_load_explicit(&q->tail, memory_order_relaxed);
+	if (tail - atomic_load_explicit(&q->head, memory_order_acquire)
+		== SIGQ_SIZE)
+	{
+		atomic_fetch_add_explicit(&q->lost, 1, memory_order_relaxed);
+		return ;
+	}
+	q->ev[tail & (SIGQ_SIZE - 1)].pid = pid;
+	q->ev[tail & (SIGQ_SIZE - 1)].sig = sig;
+	q->ev[tail & (SIGQ_SIZE - 1)].value = value;
+	q->ev[tail & (SIGQ_SIZE - 1)].time = ft_now_ns();
+	atomic_store_explicit(&q->tail, tail + 1, memory_order_release);
+}
+
+/**
+ * @brief Retire le plus ancien signal de la file (côté boucle principale)
+ * @param ev Reçoit le signal retiré
+ * @return 1 si un signal a été retiré, 0 si la file est vide
+ *
+ * Un débordement signalé par le gestionnaire est rapporté ici, hors du
+ * gestionnaire, une fois par signal perdu. Le compteur est lu et remis
+ * à zéro d'un seul échange atomique : une perte comptée par le
+ * gestionnaire pendant le rapport reste pour l'appel suivant.
+ */
+int	ft_sigq_pop(t_sigev *ev)
+{
+	t_sigq			*q;
+	unsigned int	head;
+	unsigned int	lost;
+
+	q = ft_sigq();
+	lost = atomic_exchange_explicit(&q->lost, 0, memory_order_relaxed);
+	while (lost--)
+	{
+		ft_print_colored(CROSS_MARK "File des signaux pleine, signal perdu",
+			COLOR_RED);
+	}
+	head = atomic_load_explicit(&q->head, memory_order_relaxed);
+	if (head == atomic_load_explicit(&q->tail, memory_order_acquire))
+		return (0);
+	*ev = q->ev[head & (SIGQ_SIZE - 1)];
+	atomic_store_explicit(&q->head, head + 1, memory_order_release);
+	return (1);
+}
+
+/**
+ * @brief Endort la boucle principale jusqu'à ce que la file soit non vide
+ * @param timeout_ns Attente maximale en nanosecondes, 0 pour attendre
+ *                   sans limite
+ *
+ * FUTEX_WAIT compare tail à la valeur lue et n'endort le processus que
+ * si elles sont égales, en un seul appel système : un signal publié
+ * entre le test et l'attente modifie tail et le réveil n'est pas perdu.
+ * Un signal reçu pendant l'attente l'interrompt (EINTR). Les signaux du
+ * serveur ne sont donc jamais bloqués hors du gestionnaire, sans les
+ * deux sigprocmask() par réveil qu'exigerait sigsuspend(). Le délai
+ * réveille la boucle quand un acquittement retenu par l'ordonnanceur
+ * (-R) redevient libérable sans qu'aucun signal n'arrive.
+ */
+void	ft_sigq_wait(long timeout_ns)
+{
+	t_sigq			*q;
+	unsigned int	tail;
+	struct timespec	ts;
+	struct timespec	*limit;
+
+	q = ft_sigq();
+	tail = atomic_load_explicit(&q->tail, memory_order_acquire);
+	if (tail != atomic_load_explicit(&q->head, memory_order_relaxed)
+		|| atomic_load_explicit(&q->lost, memory_order_relaxed))
+		return ;
+	limit = NULL;
+	if (timeout_ns > 0)
+	{
+		ts.tv_sec = timeout_ns / 1000000000L;
+		ts.tv_nsec = timeout_ns % 1000000000L;
+		limit = &ts;
+	}
+	syscall(SYS_futex, &q->tail, FUTEX_WAIT_PRIVATE, tail, limit, NULL, 0);
+}
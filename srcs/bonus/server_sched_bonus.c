@@ -0,0 +1,170 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   server_sched_bonus.c                               :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fdi-tria <fdi-tria@student.42lausanne.c    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 10:38:02 by fdi-tria          #+#    #+#             */
+/*   Updated: 2026/10/16 15:58:51 by fdi-tria         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/* Définition des standards POSIX pour sigqueue() et union sigval */
+#define _POSIX_C_SOURCE 199309L
+#define _XOPEN_SOURCE 700
+#define _DEFAULT_SOURCE
+#include "bonus.h"
+
+/**
+ * @brief Accès aux limites de débit du serveur
+ * @return Limites statiques, illimitées au démarrage
+ */
+t_sched_conf	*ft_sched_conf(void)
+{
+	static t_sched_conf	conf = {0, SCHED_BURST, SCHED_QUANTUM, 0};
+
+	return (&conf);
+}
+
+/**
+ * @brief Remplit le seau d'une session du temps écoulé depuis le dernier
+ *        remplissage
+ * @param s   Session du client
+ * @param now Horloge monotone en nanosecondes
+ * 
+ * Un seau en dette se remplit de rate bits par seconde, soit rate
+ * unités de jeton par nanoseconde : le produit ne déborde pas tant que
+ * le seau n'est pas plein, et un seau plein est simplement plafonné.
+ */
+static void	ft_sched_refill(t_session *s, uint64_t now)
+{
+	t_sched_conf	*conf;
+	long			room;
+	uint64_t		elapsed;
+
+	conf = ft_sched_conf();
+	elapsed = now - s->sched.stamp;
+	s->sched.stamp = now;
+	room = conf->burst * SCHED_SCALE - s->sched.tokens;
+	if (room <= 0)
+		return ;
+	if (elapsed >= (uint64_t)(room / conf->rate))
+		s->sched.tokens = conf->burst * SCHED_SCALE;
+	else
+		s->sched.tokens += (long)elapsed * conf->rate;
+}
+
+/**
+ * @brief Envoie un acquittement ou le retient pour l'ordonnanceur
+ * @param s     Session du client acquitté
+ * @param sig   SIGUSR1, ou SIGRTMIN + RT_ACK en fenêtre glissante
+ * @param value Valeur transmise par sigqueue() (numéro de séquence)
+ * 
+ * Sans -R, l'acquittement part immédiatement. Sinon, les bits reçus
+ * depuis la dernière facture sont débités du seau, quitte à le mettre
+ * en dette, et l'acquittement attend ft_sched_run. Le client ne peut
+ * envoyer la suite qu'une fois acquitté : retarder l'acquittement
+ * suffit à le ralentir, sans perdre ni mettre en file aucun signal. Un
+ * acquittement cumulatif plus récent remplace celui qui était retenu.
+ */
+void	ft_sched_ack(t_session *s, int sig, int value)
+{
+	union sigval	v;
+	long			bits;
+
+	v.sival_int = value;
+	if (!ft_sched_conf()->rate)
+	{
+		ft_trace_rec_bonus(TRACE_ACK | sig, s->pid, value);
+		sigqueue(s->pid, sig, v);
+		return ;
+	}
+	ft_sched_refill(s, ft_now_ns());
+	bits = s->stats.bits_received - s->sched.billed;
+	s->sched.billed = s->stats.bits_received;
+	s->sched.tokens -= bits * SCHED_SCALE;
+	s->sched.owed += bits;
+	s->sched.ack_sig = sig;
+	s->sched.ack_value = value;
+}
+
+/**
+ * @brief Visite une session au cours d'un tour du tourniquet
+ * @param s    Session dont un acquittement est retenu
+ * @param now  Horloge monotone en nanosecondes
+ * @param wait Délai avant qu'une dette soit remboursée, minimum conservé
+ * @return 1 si la session attend seulement un prochain tour
+ * 
+ * Tourniquet à déficit (Shreedhar et Varghese) : à chaque tour, une
+ * session solvable gagne quantum bits de crédit et son acquittement
+ * part quand le crédit couvre les bits qu'il confirme. Un gros
+ * acquittement cumulatif attend donc plusieurs tours pendant que ceux
+ * des messages courts passent. Une session servie n'a plus rien en
+ * attente : son crédit retombe à zéro.
+ */
+static int	ft_sched_visit(t_session *s, uint64_t now, long *wait)
+{
+	union sigval	v;
+	long			debt;
+
+	ft_sched_refill(s, now);
+	if (s->sched.tokens < 0)
+	{
+		debt = -s->sched.tokens / ft_sched_conf()->rate + 1;
+		if (!*wait || debt < *wait)
+			*wait = debt;
+		return (0);
+	}
+	s->sched.deficit += ft_sched_conf()->quantum;
+	if (s->sched.deficit < s->sched.owed)
+		return (1);
+	v.sival_int = s->sched.ack_value;
+	ft_trace_rec_bonus(TRACE_ACK | s->sched.ack_sig, s->pid, v.sival_int);
+	sigqueue(s->pid, s->sched.ack_sig, v);
+	s->sched.ack_sig = 0;
+	s->sched.owed = 0;
+	s->sched.deficit = 0;
+	return (0);
+}
+
+/**
+ * @brief Libère les acquittements retenus dont le client est solvable
+ * @return Nanosecondes avant le prochain tour ou le prochain
+ *         remboursement de dette, 0 si aucun acquittement n'attend
+ * 
+ * Appelé par la boucle principale après chaque vidage de la file des
+ * signaux. Un appel ne joue qu'un tour du tourniquet : si une session
+ * solvable manque encore de crédit, le tour suivant a lieu au prochain
+ * passage de la boucle, 1 ns plus tard au plus, après le décodage des
+ * signaux arrivés entre-temps. Un acquittement court retenu pendant ce
+ * temps passe ainsi au tour suivant au lieu d'attendre que les gros
+ * aient accumulé tout leur crédit. Le premier emplacement visité avance
+ * d'un cran à chaque appel, pour qu'aucun client ne soit toujours servi
+ * le premier.
+ */
+long	ft_sched_run(void)
+{
+	t_sched_conf	*conf;
+	t_session		*s;
+	long			wait;
+	int				again;
+	size_t			i;
+
+	conf = ft_sched_conf();
+	if (!conf->rate)
+		return (0);
+	wait = 0;
+	again = 0;
+	i = 0;
+	while (i < SESSION_MAX)
+	{
+		s = &ft_session_table()[(conf->cursor + i++) % SESSION_MAX];
+		if (s->pid && s->sched.ack_sig)
+			again |= ft_sched_visit(s, ft_now_ns(), &wait);
+	}
+	conf->cursor = (conf->cursor + 1) % SESSION_MAX;
+	if (again)
+		return (1);
+	return (wait);
+}
@@ -0,0 +1,76 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   server_seq_bonus.c                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fdi-tria <fdi-tria@student.42lausanne.c    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 04:53:21 by fdi-tria          #+#    #+#             */
+/*   Updated: 2026/10/16 16:12:30 by fdi-tria         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/* Définition des standards POSIX pour sigqueue() et union sigval */
+#define _POSIX_C_SOURCE 199309L
+#define _XOPEN_SOURCE 700
+#define _DEFAULT_SOURCE
+#include "bonus.h"
+
+/**
+ * @brief Envoie un acquittement cumulatif au client
+ * @param s Session du client émetteur
+ * 
+ * L'acquittement voyage sur SIGRTMIN + RT_ACK via sigqueue() : comme
+ * les unités de données, il est mis en file et porte sa valeur dans
+ * sival_int. Il confirme toutes les unités qui précèdent next_seq, la
+ * perte ou le retard d'un acquittement est donc couvert par le suivant ;
+ * l'ordonnanceur (-R) peut ainsi n'en libérer que le dernier.
+ */
+static void	ft_send_seq_ack(t_session *s)
+{
+	ft_sched_ack(s, SIGRTMIN + RT_ACK, s->next_seq);
+}
+
+/**
+ * @brief Traite une unité numérotée reçue en mode fenêtre glissante
+ * @param unit Valeur de sival_int : [seq:16 | données:16]
+ * @param s    Session du client émetteur
+ * 
+ * Le client garde plusieurs unités en vol sans attendre d'acquittement
+ * individuel. Chaque unité porte un numéro de séquence sur 16 bits :
+ * 
+ * 1. Numéro inattendu (doublon ou trou) : l'unité est ignorée et le
+ *    dernier acquittement est renvoyé, aucune donnée n'est mélangée.
+ *    Sur une session neuve, c'est un doublon arrivé après la
+ *    confirmation finale de son message : la session est refermée
+ *    sans acquittement, que le client ne saurait plus recevoir
+ * 2. Numéro attendu : les deux octets sont transmis, poids fort
+ *    d'abord, à ft_handle_char_bonus puis l'unité est acquittée
+ * 
+ * Après le '\0' terminal, la session est terminée : l'octet de
+ * bourrage éventuel est ignoré et la confirmation finale (SIGUSR2)
+ * remplace l'acquittement cumulatif.
+ */
+void	ft_receive_seq_bonus(unsigned int unit, t_session *s)
+{
+	int	shift;
+
+	if ((int)((unit >> 16) & 0xFFFF) != s->next_seq)
+	{
+		if (!s->stats.bits_received)
+			s->done = 1;
+		else
+			ft_send_seq_ack(s);
+		return ;
+	}
+	s->next_seq = (s->next_seq + 1) & 0xFFFF;
+	s->stats.bits_received += 32;
+	shift = 8;
+	while (shift >= 0 && !s->done)
+	{
+		ft_handle_char_bonus((unit >> shift) & 0xFF, s);
+		shift -= 8;
+	}
+	if (!s->done)
+		ft_send_seq_ack(s);
+}
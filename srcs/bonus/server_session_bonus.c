@@ -0,0 +1,199 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   server_session_bonus.c                             :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fdi-tria <fdi-tria@student.42lausanne.c    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 04:54:34 by fdi-tria          #+#    #+#             */
+/*   Updated: 2026/10/16 16:12:30 by fdi-tria         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "bonus.h"
+#include <errno.h>
+
+/**
+ * @brief Accès à la table des sessions du serveur
+ * @return Pointeur vers les SESSION_MAX emplacements
+ * 
+ * La table est statique : sa capacité est fixe et aucune allocation
+ * n'a lieu pendant la réception. Un emplacement dont le pid vaut 0 est
+ * libre. L'ordonnanceur (-R) la parcourt pour libérer les
+ * acquittements retenus.
+ */
+t_session	*ft_session_table(void)
+{
+	static t_session	table[SESSION_MAX];
+
+	return (table);
+}
+
+/**
+ * @brief Emplacement idéal d'un PID dans la table
+ * @param pid PID du client
+ * @return Index entre 0 et SESSION_MAX - 1
+ * 
+ * Hachage multiplicatif de Knuth : des PID consécutifs, fréquents
+ * lorsque plusieurs clients sont lancés ensemble, sont dispersés au
+ * lieu d'occuper une seule grappe de la table.
+ */
+static size_t	ft_session_hash(pid_t pid)
+{
+	return (((unsigned int)pid * 2654435761u) % SESSION_MAX);
+}
+
+/**
+ * @brief Prépare un emplacement libre pour un nouveau client
+ * @param s   Emplacement à initialiser
+ * @param pid PID du client
+ * 
+ * Le seau de la limite de débit (-R) part vide : la rafale -B se gagne
+ * en restant sous le débit, elle n'est pas offerte à chaque message.
+ */
+static void	ft_session_init(t_session *s, pid_t pid)
+{
+	s->pid = pid;
+	s->done = 0;
+	s->bit_count = 0;
+	s->c = 0;
+	s->next_seq = 0;
+	s->bit_seq = 0;
+	s->msg_bytes = 0;
+	s->sym_state = SYM_IDLE;
+	s->ring = NULL;
+	s->out_len = 0;
+	s->lz.state = LZ_IDLE;
+	s->huff.state = HUF_IDLE;
+	s->frame.state = FRAME_IDLE;
+	s->frame.buf = NULL;
+	s->lane.state = LANE_IDLE;
+	s->sched.stamp = ft_now_ns();
+	s->sched.tokens = 0;
+	s->sched.deficit = 0;
+	s->sched.owed = 0;
+	s->sched.billed = 0;
+	s->sched.ack_sig = 0;
+	ft_stats_reset(&s->stats, pid);
+	ft_handle_new_client(s);
+}
+
+/**
+ * @brief Libère les sessions abandonnées d'une table pleine
+ * @return 1 si au moins un emplacement a été libéré
+ * 
+ * Un client tué en plein message n'envoie jamais son '\0' : sans cette
+ * reprise, SESSION_MAX clients disparus suffiraient à bloquer le
+ * serveur. Une session est abandonnée si son client n'existe plus
+ * (kill(pid, 0) échoue avec ESRCH) ou s'il se tait depuis
+ * SESSION_IDLE_US. Le texte déjà reçu est affiché, puis clos par un
+ * retour à la ligne. ft_session_remove remonte dans le trou une entrée
+ * suivante : l'emplacement est alors examiné de nouveau.
+ */
+static int	ft_session_reap(void)
+{
+	t_session	*table;
+	uint64_t	now;
+	size_t		i;
+	int			freed;
+
+	table = ft_session_table();
+	now = ft_now_ns();
+	freed = 0;
+	i = 0;
+	while (i < SESSION_MAX)
+	{
+		if (table[i].pid && (now - table[i].stats.end
+				> (uint64_t)SESSION_IDLE_US * 1000
+				|| (kill(table[i].pid, 0) == -1 && errno == ESRCH)))
+		{
+			ft_session_flush(&table[i]);
+			if (table[i].stats.chars_received)
+				ft_putchar_bonus('\n');
+			ft_session_remove(&table[i]);
+			freed = 1;
+		}
+		else
+			i++;
+	}
+	return (freed);
+}
+
+/**
+ * @brief Retrouve la session d'un client, ou la crée
+ * @param pid PID de l'émetteur (siginfo_t->si_pid)
+ * @return La session, ou NULL si la table est pleine
+ * 
+ * Sondage linéaire à partir de l'emplacement idéal : le premier
+ * emplacement portant ce PID est la session existante, le premier
+ * emplacement libre accueille une nouvelle session. Table pleine : les
+ * sessions abandonnées sont libérées (ft_session_reap) et le sondage
+ * reprend ; s'il n'y en a aucune, le signal est ignoré sans
+ * acquittement et le client patiente.
+ */
+t_session	*ft_session_get(pid_t pid)
+{
+	t_session	*table;
+	size_t		idx;
+	size_t		probes;
+
+	table = ft_session_table();
+	idx = ft_session_hash(pid);
+	probes = 0;
+	while (probes < SESSION_MAX)
+	{
+		if (table[idx].pid == pid)
+			return (&table[idx]);
+		if (!table[idx].pid)
+		{
+			ft_session_init(&table[idx], pid);
+			return (&table[idx]);
+		}
+		idx = (idx + 1) % SESSION_MAX;
+		if (++probes == SESSION_MAX && ft_session_reap())
+		{
+			idx = ft_session_hash(pid);
+			probes = 0;
+		}
+	}
+	return (NULL);
+}
+
+/**
+ * @brief Libère l'emplacement d'une session terminée
+ * @param s Session à retirer
+ * 
+ * Suppression par décalage arrière, sans pierre tombale : les entrées
+ * suivantes de la grappe qui ne sont pas à leur emplacement idéal
+ * remontent dans le trou, pour que chaque PID reste atteignable par le
+ * sondage linéaire de ft_session_get. Le trou est marqué libre avant
+ * le parcours : même dans une table pleine, celui-ci s'arrête. L'anneau partagé éventuel (-m)
+ * et le tampon de trame (-l) sont libérés avant que l'emplacement ne
+ * soit réutilisé.
+ */
+void	ft_session_remove(t_session *s)
+{
+	t_session	*table;
+	size_t		hole;
+	size_t		next;
+	size_t		home;
+
+	ft_shm_release(s);
+	ft_frame_release(s);
+	table = ft_session_table();
+	hole = s - table;
+	table[hole].pid = 0;
+	next = (hole + 1) % SESSION_MAX;
+	while (table[next].pid)
+	{
+		home = ft_session_hash(table[next].pid);
+		if ((next - home + SESSION_MAX) % SESSION_MAX
+			>= (next - hole + SESSION_MAX) % SESSION_MAX)
+		{
+			table[hole] = table[next];
+			table[next].pid = 0;
+			hole = next;
+		}
+		next = (next + 1) % SESSION_MAX;
+	}
+}
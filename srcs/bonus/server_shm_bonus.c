@@ -0,0 +1,171 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   server_shm_bonus.c                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fdi-tria <fdi-tria@student.42lausanne.c    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 04:57:00 by fdi-tria          #+#    #+#             */
+/*   Updated: 2026/10/16 16:12:30 by fdi-tria         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/* Définition des standards POSIX pour shm_open() et ftruncate() */
+#define _POSIX_C_SOURCE 199309L
+#define _XOPEN_SOURCE 700
+#define _DEFAULT_SOURCE
+#include "bonus.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+
+/**
+ * @brief Crée le segment partagé d'un client et le dimensionne
+ * @param name Nom du segment (ft_shm_name)
+ * @return Descripteur du segment, ou -1 en cas d'échec
+ * 
+ * Un segment laissé par un client interrompu porte peut-être déjà ce
+ * nom (PID recyclé) : il est supprimé puis recréé une seule fois.
+ */
+static int	ft_shm_create(const char *name)
+{
+	int	fd;
+
+	fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0600);
+	if (fd == -1)
+	{
+		shm_unlink(name);
+		fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0600);
+	}
+	if (fd != -1 && ftruncate(fd, sizeof(t_ring) + SHM_RING_SIZE) == -1)
+	{
+		close(fd);
+		shm_unlink(name);
+		return (-1);
+	}
+	return (fd);
+}
+
+/**
+ * @brief Répond à l'octet CTL_SHM en créant l'anneau du client
+ * @param s Session du client émetteur
+ * 
+ * Le segment est créé et projeté avant que le dernier bit de CTL_SHM
+ * ne soit acquitté : quand le client reçoit ce SIGUSR1, il peut ouvrir
+ * le segment. En cas d'échec, s->ring reste NULL, le client ne trouve
+ * pas le segment et poursuit bit par bit sur la même session.
+ */
+void	ft_shm_attach(t_session *s)
+{
+	char	name[SHM_NAME_MAX];
+	int		fd;
+	void	*map;
+
+	ft_shm_name(name, getpid(), s->pid);
+	fd = ft_shm_create(name);
+	if (fd == -1)
+		return ;
+	map = mmap(NULL, sizeof(t_ring) + SHM_RING_SIZE,
+			PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+	if (map == MAP_FAILED)
+	{
+		shm_unlink(name);
+		return ;
+	}
+	s->ring = map;
+	atomic_init(&s->ring->head, 0);
+	atomic_init(&s->ring->tail, 0);
+	atomic_init(&s->ring->waiting, 0);
+	s->ring->size = SHM_RING_SIZE;
+}
+
+/**
+ * @brief Affiche une portion contiguë de l'anneau
+ * @param s    Session du client
+ * @param head Position absolue du premier octet à lire
+ * @param tail Position absolue de fin des octets publiés
+ * @return Nombre d'octets consommés, '\0' terminal compris
+ * 
+ * Le texte est copié depuis le segment vers le tampon de sortie, sans
+ * passer par le tampon de session ; une portion plus grande que le
+ * tampon de sortie est écrite directement par un seul write(). Le '\0'
+ * terminal passe par ft_handle_char_bonus, qui clôt le message comme
+ * dans les autres modes.
+ */
+static size_t	ft_shm_consume(t_session *s, size_t head, size_t tail)
+{
+	const unsigned char	*data;
+	size_t				len;
+	size_t				n;
+
+	data = s->ring->data + (head & (s->ring->size - 1));
+	len = s->ring->size - (head & (s->ring->size - 1));
+	if (len > tail - head)
+		len = tail - head;
+	n = 0;
+	while (n < len && data[n])
+		n++;
+	ft_session_flush(s);
+	ft_out_write_bonus((const char *)data, n);
+	s->stats.chars_received += n;
+	s->stats.bits_received += n * 8;
+	if (n == len)
+		return (n);
+	ft_handle_char_bonus(0, s);
+	return (n + 1);
+}
+
+/**
+ * @brief Vide l'anneau d'un client sur réception de la sonnette
+ * @param s Session du client émetteur
+ * 
+ * SIGRTMIN + RT_DOORBELL ne porte aucune donnée : il signale seulement
+ * que l'anneau est passé de vide à non vide. Le serveur consomme donc
+ * jusqu'à trouver l'anneau vide, en relisant tail après chaque portion
+ * puisque le client continue d'écrire pendant ce temps. Une sonnette
+ * qui ouvre une session, sans anneau, survit à un message terminé : la
+ * session est refermée aussitôt.
+ * 
+ * Ordre des accès (séquentiellement cohérent des deux côtés) :
+ * - head est publié avant de lire waiting, le client écrit waiting
+ *   avant de relire head : l'un des deux voit toujours l'autre, un
+ *   client bloqué sur un anneau plein est donc toujours réveillé
+ */
+void	ft_shm_drain(t_session *s)
+{
+	size_t	head;
+	size_t	tail;
+
+	if (!s->ring)
+	{
+		if (!s->stats.bits_received)
+			s->done = 1;
+		return ;
+	}
+	head = atomic_load_explicit(&s->ring->head, memory_order_relaxed);
+	tail = atomic_load_explicit(&s->ring->tail, memory_order_acquire);
+	while (head != tail && !s->done)
+	{
+		head += ft_shm_consume(s, head, tail);
+		atomic_store(&s->ring->head, head);
+		tail = atomic_load_explicit(&s->ring->tail, memory_order_acquire);
+	}
+	if (!s->done && atomic_exchange(&s->ring->waiting, 0))
+		ft_sched_ack(s, SIGUSR1, 0);
+}
+
+/**
+ * @brief Détache et supprime l'anneau d'une session terminée
+ * @param s Session retirée de la table
+ */
+void	ft_shm_release(t_session *s)
+{
+	char	name[SHM_NAME_MAX];
+
+	if (!s->ring)
+		return ;
+	munmap(s->ring, sizeof(t_ring) + SHM_RING_SIZE);
+	s->ring = NULL;
+	ft_shm_name(name, getpid(), s->pid);
+	shm_unlink(name);
+}
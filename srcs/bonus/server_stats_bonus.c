@@ -0,0 +1,125 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   server_stats_bonus.c                               :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fdi-tria <fdi-tria@student.42lausanne.c    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 13:12:40 by fdi-tria          #+#    #+#             */
+/*   Updated: 2026/10/16 13:34:52 by fdi-tria         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "bonus.h"
+
+/**
+ * @brief Remet à zéro les statistiques d'un nouveau message
+ * @param stats Statistiques de la session ou du groupe de voies
+ * @param pid   PID du client émetteur
+ */
+void	ft_stats_reset(t_stats *stats, pid_t pid)
+{
+	stats->chars_received = 0;
+	stats->bits_received = 0;
+	stats->start = 0;
+	stats->end = 0;
+	stats->max_gap = 0;
+	stats->client_pid = pid;
+	stats->verbose_mode = 0;
+}
+
+/**
+ * @brief Enregistre l'arrivée d'un signal du client
+ * @param stats Statistiques de la session
+ * @param now   Instant d'arrivée relevé par le gestionnaire (t_sigev)
+ *
+ * Le premier signal ouvre la mesure ; les suivants prolongent sa fin
+ * et retiennent la plus longue attente entre deux signaux, qui désigne
+ * un client ralenti, un acquittement retenu (-R) ou une retransmission.
+ */
+void	ft_stats_tick(t_stats *stats, uint64_t now)
+{
+	if (!stats->start)
+		stats->start = now;
+	else if (now - stats->end > stats->max_gap)
+		stats->max_gap = now - stats->end;
+	stats->end = now;
+}
+
+/**
+ * @brief Ajoute les statistiques d'une voie à celles de son groupe
+ * @param dst Statistiques du message complet (-j)
+ * @param src Statistiques de la session d'une voie
+ *
+ * La durée va de la première arrivée de la première voie à la dernière
+ * arrivée de la dernière : le débit rapporté est celui du message
+ * entier. Les caractères sont comptés à l'affichage du groupe.
+ */
+void	ft_stats_merge(t_stats *dst, const t_stats *src)
+{
+	dst->bits_received += src->bits_received;
+	if (!src->start)
+		return ;
+	if (!dst->start || src->start < dst->start)
+		dst->start = src->start;
+	if (src->end > dst->end)
+		dst->end = src->end;
+	if (src->max_gap > dst->max_gap)
+		dst->max_gap = src->max_gap;
+}
+
+/**
+ * @brief Affiche une ligne du rapport : coche verte, libellé, valeur, unité
+ * @param label Libellé suivi de son séparateur
+ * @param value Valeur sur 64 bits
+ * @param unit  Unité précédée d'une espace, ou chaîne vide
+ */
+static void	ft_stat_line(const char *label, uint64_t value, const char *unit)
+{
+	ft_putstr_bonus(COLOR_GREEN CHECK_MARK COLOR_RESET);
+	ft_putstr_bonus(label);
+	ft_putnbr_u64_bonus(value);
+	ft_putstr_bonus(unit);
+	ft_putchar_bonus('\n');
+}
+
+/**
+ * @brief Affiche un rapport détaillé des statistiques de communication
+ * @param stats Pointeur vers la structure contenant les statistiques
+ *
+ * Exemple de sortie :
+ * === Statistiques de Réception ===
+ * ✓ Message reçu du client PID: 12345
+ * ✓ Caractères reçus : 42
+ * ✓ Bits reçus : 336
+ * ✓ Durée : 2874 µs
+ * ✓ Débit : 116910 bits/s, 14613 octets/s
+ * ✓ Intervalle moyen par bit : 8553 ns
+ * ✓ Pause maximale : 412 µs
+ *
+ * La durée court de l'arrivée du premier signal à celle du dernier :
+ * un message d'un seul signal (mémoire partagée, par exemple) affiche
+ * une durée et un débit nuls. Toutes les valeurs passent par
+ * ft_putnbr_u64_bonus, sans troncature à 32 bits.
+ */
+void	ft_print_stats(t_stats *stats)
+{
+	uint64_t	elapsed;
+
+	elapsed = stats->end - stats->start;
+	ft_putstr_bonus(COLOR_BLUE "\n=== Statistiques de Réception ===\n");
+	ft_stat_line(" Message reçu du client PID: ", stats->client_pid, "");
+	ft_stat_line(" Caractères reçus : ", stats->chars_received, "");
+	ft_stat_line(" Bits reçus : ", stats->bits_received, "");
+	ft_stat_line(" Durée : ", elapsed / 1000, " µs");
+	ft_putstr_bonus(COLOR_GREEN CHECK_MARK COLOR_RESET " Débit : ");
+	ft_putnbr_u64_bonus(ft_per_sec(stats->bits_received, elapsed));
+	ft_putstr_bonus(" bits/s, ");
+	ft_putnbr_u64_bonus(ft_per_sec(stats->chars_received, elapsed));
+	ft_putstr_bonus(" octets/s\n");
+	if (stats->bits_received)
+		ft_stat_line(" Intervalle moyen par bit : ",
+			elapsed / stats->bits_received, " ns");
+	ft_stat_line(" Pause maximale : ", stats->max_gap / 1000, " µs");
+	ft_putstr_bonus("\n" COLOR_RESET);
+}
@@ -0,0 +1,117 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   server_sym_bonus.c                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fdi-tria <fdi-tria@student.42lausanne.c    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 08:06:19 by fdi-tria          #+#    #+#             */
+/*   Updated: 2026/10/16 14:58:05 by fdi-tria         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/* Définition des standards POSIX pour sigqueue() et SIGRTMAX */
+#define _POSIX_C_SOURCE 199309L
+#define _XOPEN_SOURCE 700
+#define _DEFAULT_SOURCE
+#include "bonus.h"
+
+/**
+ * @brief Nombre de bits par symbole que le serveur sait recevoir
+ * @return Le plus grand k <= SYM_MAX_BITS tel que 2^k signaux tiennent
+ *         entre SIGRTMIN + RT_SYM et SIGRTMAX
+ *
+ * SIGRTMIN et SIGRTMAX ne sont pas des constantes sous glibc : quelques
+ * signaux temps réel sont réservés à la bibliothèque de threads. Avec
+ * 31 signaux dont RT_SYM déjà pris, il en reste 27, soit 16 symboles.
+ */
+int	ft_sym_max_bits(void)
+{
+	int	n;
+	int	bits;
+
+	n = SIGRTMAX - (SIGRTMIN + RT_SYM) + 1;
+	bits = 0;
+	while (bits < SYM_MAX_BITS && (2 << bits) <= n)
+		bits++;
+	return (bits);
+}
+
+/**
+ * @brief Prépare la négociation de l'alphabet après l'octet CTL_SYM
+ * @param s Session du client émetteur
+ *
+ * L'octet suivant, toujours envoyé bit par bit, est la proposition du
+ * client : ft_handle_char_bonus le confie à ft_sym_accept.
+ */
+void	ft_sym_start(t_session *s)
+{
+	s->sym_state = SYM_PROPOSE;
+	s->sym_bits = 0;
+}
+
+/**
+ * @brief Retient la taille d'alphabet et la communique au client
+ * @param bits Bits par symbole proposés par le client
+ * @param s    Session du client émetteur
+ * @return 1 si la proposition est acceptée, 0 sinon
+ *
+ * La réponse part sur SIGRTMIN + RT_ACK avant l'acquittement du dernier
+ * bit de la proposition : quand le client reçoit ce SIGUSR1, la valeur
+ * retenue l'attend déjà dans sa file. Une proposition trop grande pour
+ * le serveur est ramenée à son maximum.
+ *
+ * Seul un client lancé avec -a propose de 1 à SYM_MAX_BITS bits et
+ * attend la réponse : hors de cet intervalle, l'octet n'est pas une
+ * proposition et rien n'est envoyé, car SIGRTMIN + RT_ACK tuerait un
+ * client qui ne l'a pas bloqué. La session revient alors au texte en
+ * clair et l'appelant traite l'octet comme tel.
+ */
+int	ft_sym_accept(unsigned char bits, t_session *s)
+{
+	union sigval	value;
+	int				max;
+
+	if (bits < 1 || bits > SYM_MAX_BITS)
+	{
+		s->sym_state = SYM_IDLE;
+		return (0);
+	}
+	max = ft_sym_max_bits();
+	s->sym_bits = bits;
+	if (s->sym_bits > max)
+		s->sym_bits = max;
+	s->sym_state = SYM_DATA;
+	value.sival_int = s->sym_bits;
+	ft_trace_rec_bonus(TRACE_ACK | (SIGRTMIN + RT_ACK), s->pid, s->sym_bits);
+	sigqueue(s->pid, SIGRTMIN + RT_ACK, value);
+	return (1);
+}
+
+/**
+ * @brief Décode un symbole reçu sur SIGRTMIN + RT_SYM + sym
+ * @param sym Rang du signal dans l'alphabet
+ * @param s   Session du client émetteur
+ *
+ * Le symbole porte sym_bits bits du message, poids fort d'abord : ils
+ * suivent un à un le chemin du mode bit par bit (ft_receive_bit_bonus).
+ * Les bits de bourrage du dernier symbole, après le '\0' terminal, sont
+ * ignorés puisque la session est alors terminée. Un symbole hors
+ * négociation ou hors alphabet est ignoré.
+ */
+void	ft_receive_sym_bonus(int sym, t_session *s)
+{
+	int	bit;
+
+	if (s->sym_state != SYM_DATA || sym >= (1 << s->sym_bits))
+		return ;
+	bit = s->sym_bits - 1;
+	while (bit >= 0 && !s->done)
+	{
+		if ((sym >> bit) & 1)
+			ft_receive_bit_bonus(SIGUSR2, s);
+		else
+			ft_receive_bit_bonus(SIGUSR1, s);
+		bit--;
+	}
+}
@@ -0,0 +1,181 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   trace_bonus.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fdi-tria <fdi-tria@student.42lausanne.c    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 13:46:21 by fdi-tria          #+#    #+#             */
+/*   Updated: 2026/10/16 14:18:37 by fdi-tria         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/* Définition des standards POSIX pour mmap(), ftruncate() et pread() */
+#define _POSIX_C_SOURCE 199309L
+#define _XOPEN_SOURCE 700
+#define _DEFAULT_SOURCE
+#include "bonus.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/**
+ * @brief Accès au journal du processus
+ * @return Le journal, inactif tant que ft_trace_init_bonus ne l'a pas
+ *         ouvert
+ */
+static t_trace	*ft_trace(void)
+{
+	static t_trace	trace;
+
+	return (&trace);
+}
+
+/**
+ * @brief Valide l'en-tête d'un journal existant, ou dimensionne un neuf
+ * @param fd  Fichier ouvert en lecture et écriture
+ * @param hdr Reçoit l'en-tête lu sur le disque
+ * @return Capacité en événements, 0 si le fichier n'est pas un journal
+ *         du protocole bonus
+ *
+ * Un fichier vide est porté à TRACE_CAP événements ; ftruncate() le
+ * remplit de zéros, donc head et tous les stamp partent de 0. Un
+ * fichier de cette taille dont l'en-tête est encore nul vient d'être
+ * créé par un autre processus, qui l'écrit au même moment.
+ */
+static uint32_t	ft_trace_cap(int fd, t_trace_hdr *hdr)
+{
+	struct stat	st;
+	off_t		size;
+	int			i;
+
+	size = sizeof(t_trace_hdr) + (off_t)TRACE_CAP * sizeof(t_trace_ev);
+	if (fstat(fd, &st) == -1)
+		return (0);
+	if (st.st_size == 0 && ftruncate(fd, size) == -1)
+		return (0);
+	if (st.st_size == 0)
+		return (TRACE_CAP);
+	if (pread(fd, hdr, sizeof(*hdr), 0) != sizeof(*hdr))
+		return (0);
+	if (!hdr->magic[0] && st.st_size == size)
+		return (TRACE_CAP);
+	i = -1;
+	while (++i < 8)
+		if (hdr->magic[i] != TRACE_MAGIC[i])
+			return (0);
+	size = sizeof(*hdr) + (off_t)hdr->cap * (off_t)sizeof(t_trace_ev);
+	if (hdr->version != TRACE_VERSION || hdr->proto != TRACE_BONUS
+		|| !hdr->cap || (hdr->cap & (hdr->cap - 1)) || st.st_size != size)
+		return (0);
+	return (hdr->cap);
+}
+
+/**
+ * @brief Projette le journal en mémoire partagée et écrit son en-tête
+ * @param t  Journal du processus
+ * @param fd Fichier ouvert en lecture et écriture
+ * @return 0 en cas de succès, -1 en cas d'échec
+ *
+ * MAP_SHARED : les événements vont directement dans le cache de pages
+ * du fichier, sans write(), et les autres processus qui l'ont projeté
+ * les voient aussitôt. Le marqueur magique est écrit en dernier, de
+ * la fin vers le début : un lecteur ne reconnaît le journal qu'une
+ * fois son en-tête complet.
+ */
+static int	ft_trace_map(t_trace *t, int fd)
+{
+	t_trace_hdr	disk;
+	uint32_t	cap;
+	void		*map;
+	int			i;
+
+	cap = ft_trace_cap(fd, &disk);
+	if (!cap)
+		return (-1);
+	map = mmap(NULL, sizeof(t_trace_hdr) + (size_t)cap * sizeof(t_trace_ev),
+			PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	if (map == MAP_FAILED)
+		return (-1);
+	t->hdr = map;
+	t->ev = (t_trace_ev *)(t->hdr + 1);
+	if (t->hdr->magic[0])
+		return (0);
+	t->hdr->version = TRACE_VERSION;
+	t->hdr->cap = cap;
+	t->hdr->proto = TRACE_BONUS;
+	t->hdr->rtmin = SIGRTMIN;
+	i = 8;
+	while (i--)
+		t->hdr->magic[i] = TRACE_MAGIC[i];
+	return (0);
+}
+
+/**
+ * @brief Ouvre le journal désigné par MT_TRACE, une fois par processus
+ *
+ * Appelée au démarrage du serveur et du client, jamais depuis un
+ * gestionnaire : open() et mmap() n'ont lieu qu'ici. Un processus de
+ * voie (-j) la rappelle après fork() : il garde la projection héritée
+ * du parent et enregistre désormais sous son propre PID. Sans
+ * MT_TRACE, ou si le fichier est inutilisable, le journal reste
+ * inactif et le programme fonctionne normalement.
+ */
+void	ft_trace_init_bonus(void)
+{
+	t_trace		*t;
+	const char	*path;
+	int			fd;
+
+	t = ft_trace();
+	t->self = getpid();
+	if (t->tried)
+		return ;
+	t->tried = 1;
+	path = getenv("MT_TRACE");
+	if (!path || !*path)
+		return ;
+	fd = open(path, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+	if (fd == -1 || ft_trace_map(t, fd) == -1)
+		ft_print_colored("Erreur: MT_TRACE inutilisable, journal désactivé",
+			COLOR_RED);
+	if (fd != -1)
+		close(fd);
+}
+
+/**
+ * @brief Enregistre un signal émis ou reçu
+ * @param what  TRACE_SEND, TRACE_RECV, TRACE_ACK ou TRACE_ACKED,
+ *              combiné au numéro du signal
+ * @param peer  Destinataire du signal, ou son émetteur (si_pid)
+ * @param value Valeur attachée au signal
+ *
+ * Sans verrou et async-signal-safe : clock_gettime(), un fetch_add
+ * sur head qui réserve le rang, cinq écritures, puis la publication
+ * de stamp avec la sémantique release. Les processus qui partagent le
+ * fichier réservent leurs rangs sur le même compteur ; stamp est remis
+ * à 0 avant l'écriture pour qu'un lecteur écarte l'emplacement pendant
+ * qu'il est réécrit. Journal inactif : un seul test.
+ */
+void	ft_trace_rec_bonus(int what, pid_t peer, int value)
+{
+	t_trace		*t;
+	t_trace_ev	*ev;
+	uint64_t	rank;
+	uint64_t	now;
+
+	t = ft_trace();
+	if (!t->hdr)
+		return ;
+	now = ft_now_ns();
+	rank = atomic_fetch_add_explicit(&t->hdr->head, 1, memory_order_relaxed);
+	ev = &t->ev[rank & (t->hdr->cap - 1)];
+	atomic_store_explicit(&ev->stamp, 0, memory_order_relaxed);
+	atomic_thread_fence(memory_order_release);
+	ev->time = now;
+	ev->self = t->self;
+	ev->peer = peer;
+	ev->value = value;
+	ev->what = what;
+	atomic_store_explicit(&ev->stamp, rank + 1, memory_order_release);
+}
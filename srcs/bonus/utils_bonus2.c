@@ -6,65 +6,12 @@
 /*   By: fdi-tria <fdi-tria@student.42lausanne.c    +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/01/25 20:45:20 by fdi-tria          #+#    #+#             */
-/*   Updated: 2025/01/26 00:33:53 by fdi-tria         ###   ########.fr       */
+/*   Updated: 2026/10/16 13:34:52 by fdi-tria         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #include "bonus.h"
 
-/**
- * @brief Affiche un rapport détaillé des statistiques de communication
- * @param stats Pointeur vers la structure contenant les statistiques
- * 
- * Cette fonction crée un rapport visuel élaboré des
- * statistiques de communication
- * en utilisant une mise en forme colorée et des symboles pour améliorer la
- * lisibilité. Le rapport présente trois métriques principales :
- * 
- * 1. PID du client émetteur
- * 2. Nombre total de caractères reçus
- * 3. Nombre total de bits traités
- * 
- * Format de présentation :
- * - Titre en bleu avec séparateurs
- * - Chaque métrique précédée d'une coche verte (CHECK_MARK)
- * - Retour à la couleur par défaut après chaque élément coloré
- * - Espacement vertical pour une meilleure lisibilité
- * 
- * Exemple de sortie :
- * === Statistiques de Réception ===
- * ✓ Message reçu du client PID: 12345
- * ✓ Caractères reçus : 42
- * ✓ Bits reçus : 336
- * 
- * @note Cette fonction utilise les constantes de couleur définies
- *       (COLOR_BLUE, COLOR_GREEN, COLOR_RESET) pour le formatage
- */
-void	ft_print_stats(t_stats *stats)
-{
-	ft_putstr_bonus(COLOR_BLUE);
-	ft_putstr_bonus("\n=== Statistiques de Réception ===\n");
-	ft_putstr_bonus(COLOR_GREEN);
-	ft_putstr_bonus(CHECK_MARK);
-	ft_putstr_bonus(COLOR_RESET);
-	ft_putstr_bonus(" Message reçu du client PID: ");
-	ft_putnbr_bonus(stats->client_pid);
-	ft_putchar_bonus('\n');
-	ft_putstr_bonus(COLOR_GREEN);
-	ft_putstr_bonus(CHECK_MARK);
-	ft_putstr_bonus(COLOR_RESET);
-	ft_putstr_bonus(" Caractères reçus : ");
-	ft_putnbr_bonus(stats->chars_received);
-	ft_putchar_bonus('\n');
-	ft_putstr_bonus(COLOR_GREEN);
-	ft_putstr_bonus(CHECK_MARK);
-	ft_putstr_bonus(COLOR_RESET);
-	ft_putstr_bonus(" Bits reçus : ");
-	ft_putnbr_bonus(stats->bits_received);
-	ft_putstr_bonus("\n\n");
-	ft_putstr_bonus(COLOR_RESET);
-}
-
 /**
  * @brief Affiche un message avec une couleur spécifique
  * @param msg   Message à afficher
@@ -156,3 +103,46 @@ int	ft_atoi_bonus(const char *str)
 	}
 	return (sign * result);
 }
+
+/**
+ * @brief Ajoute l'écriture décimale d'un PID à la fin d'une chaîne
+ * @param dst Position d'écriture (avancée par la fonction)
+ * @param pid PID strictement positif
+ */
+static void	ft_append_pid(char **dst, pid_t pid)
+{
+	char	digits[12];
+	int		len;
+
+	len = 0;
+	while (pid > 0)
+	{
+		digits[len++] = '0' + pid % 10;
+		pid /= 10;
+	}
+	while (len > 0)
+		*(*dst)++ = digits[--len];
+}
+
+/**
+ * @brief Construit le nom du segment de mémoire partagée d'un client
+ * @param name   Tampon d'au moins SHM_NAME_MAX octets
+ * @param server PID du serveur
+ * @param client PID du client
+ * 
+ * Le client et le serveur calculent chacun ce nom de leur côté : seul
+ * l'octet CTL_SHM circule pendant la poignée de main. Le PID du client
+ * donne un anneau à un seul producteur par émetteur.
+ */
+void	ft_shm_name(char *name, pid_t server, pid_t client)
+{
+	const char	*prefix;
+
+	prefix = "/minitalk_";
+	while (*prefix)
+		*name++ = *prefix++;
+	ft_append_pid(&name, server);
+	*name++ = '_';
+	ft_append_pid(&name, client);
+	*name = '\0';
+}
@@ -0,0 +1,94 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   utils_bonus3.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fdi-tria <fdi-tria@student.42lausanne.c    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 05:10:12 by fdi-tria          #+#    #+#             */
+/*   Updated: 2026/10/16 13:34:52 by fdi-tria         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/* Définition des standards POSIX pour clock_gettime() */
+#define _POSIX_C_SOURCE 199309L
+#define _XOPEN_SOURCE 700
+#define _DEFAULT_SOURCE
+#include "bonus.h"
+#include <time.h>
+
+/**
+ * @brief Lit l'horloge monotone en nanosecondes
+ * @return Nanosecondes écoulées depuis une origine arbitraire fixe
+ *
+ * CLOCK_MONOTONIC ne recule jamais, contrairement à l'heure murale qui
+ * peut être ajustée pendant une mesure. clock_gettime() est
+ * async-signal-safe et, sous Linux, servie par le vDSO sans appel
+ * système : l'horodatage de chaque bit reste négligeable.
+ */
+uint64_t	ft_now_ns(void)
+{
+	struct timespec	ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ((uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec);
+}
+
+/**
+ * @brief Affiche un entier non signé de 64 bits
+ * @param n Valeur à afficher
+ *
+ * Variante de ft_putnbr_bonus pour les compteurs qui dépassent INT_MAX
+ * (durées en nanosecondes, débits) : 20 chiffres au plus, rendus de
+ * droite à gauche puis ajoutés au tampon de sortie en un seul appel.
+ */
+void	ft_putnbr_u64_bonus(uint64_t n)
+{
+	char	digits[20];
+	int		i;
+
+	i = 20;
+	while (i == 20 || n)
+	{
+		digits[--i] = '0' + n % 10;
+		n /= 10;
+	}
+	ft_out_write_bonus(digits + i, 20 - i);
+}
+
+/**
+ * @brief Calcule la longueur d'une chaîne
+ * @param str Chaîne terminée par '\0'
+ * @return Nombre d'octets avant le '\0'
+ */
+size_t	ft_strlen_bonus(const char *str)
+{
+	size_t	len;
+
+	len = 0;
+	while (str[len])
+		len++;
+	return (len);
+}
+
+/**
+ * @brief Convertit un compte sur une durée en débit par seconde
+ * @param count Quantité mesurée (bits, octets)
+ * @param ns    Durée de la mesure, en nanosecondes
+ * @return count par seconde, 0 si la durée est nulle
+ *
+ * count * 10^9 déborde 64 bits au-delà de 18 Gbit (une session de
+ * 2 Gio) : les deux termes sont divisés par deux autant que
+ * nécessaire, ce qui ne coûte que les bits de poids faible du débit.
+ */
+uint64_t	ft_per_sec(uint64_t count, uint64_t ns)
+{
+	while (count > UINT64_MAX / 1000000000ull)
+	{
+		count >>= 1;
+		ns >>= 1;
+	}
+	if (!ns)
+		return (0);
+	return (count * 1000000000ull / ns);
+}
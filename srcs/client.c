@@ -6,7 +6,7 @@
 /*   By: fdi-tria <fdi-tria@student.42lausanne.c    +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/01/25 19:16:45 by fdi-tria          #+#    #+#             */
-/*   Updated: 2025/01/26 00:40:09 by fdi-tria         ###   ########.fr       */
+/*   Updated: 2026/10/16 14:36:20 by fdi-tria         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -18,7 +18,7 @@
  * 
  * 1. _POSIX_C_SOURCE 199309L :
  *    - Active les fonctionnalités POSIX.1b de 1993
- *    - Nécessaire pour sigaction, sig_atomic_t et autres fonctions temps réel
+ *    - Nécessaire pour sigqueue, sigtimedwait et autres fonctions temps réel
  *    - La valeur 199309L correspond à la version POSIX.1b de septembre 1993
  * 
  * 2. _XOPEN_SOURCE 700 :
@@ -40,151 +40,120 @@
 #include "minitalk.h"
 
 /**
- * @brief Variable globale pour la synchronisation inter-processus
- * 
- * Cette variable est essentielle au protocole de communication :
- * - volatile : Empêche l'optimisation qui masquerait les changements
- * - sig_atomic_t : Garantit des opérations atomiques
- * - Initialisation à 0 : État initial "pas de confirmation reçue"
- * 
- * Son utilisation est justifiée car c'est le seul moyen sûr de
- * communiquer entre un gestionnaire de signal et le programme principal.
- */
-static volatile sig_atomic_t	g_signal_received = 0;
-
-/**
- * @brief Gestionnaire de signaux pour le protocole client
- * @param sig Signal reçu (SIGUSR1 pour ACK, SIGUSR2 pour fin)
- * 
- * Implémente un protocole de confirmation à deux niveaux :
- * 
- * 1. Confirmation de bit (SIGUSR1) :
- *    - Active le drapeau g_signal_received
- *    - Permet la progression de la transmission
- * 
- * 2. Confirmation finale (SIGUSR2) :
- *    - Indique la réception complète du message
- *    - Affiche une confirmation
- *    - Termine proprement le programme
- * 
- * Aspects de sécurité :
- * - Utilisation de write() au lieu de printf() dans le handler
- * - Opérations minimales pour éviter les problèmes de réentrance
- * - Gestion atomique du drapeau de synchronisation
- */
-static void	ft_sig_handler(int sig)
-{
-	if (sig == SIGUSR2)
-	{
-		write(1, "Message received by server\n", 26);
-		exit(0);
-	}
-	g_signal_received = 1;
-}
-
-/**
- * @brief Transmet un bit unique avec confirmation
- * @param pid PID du serveur destinataire
- * @param bit_val Valeur du bit (0 ou 1)
- * 
- * Cette fonction implémente le protocole de base avec :
- * 
- * 1. Préparation :
- *    - Réinitialisation du drapeau de confirmation
- *    - Sélection du signal approprié
- * 
- * 2. Transmission :
- *    - SIGUSR2 pour bit 1
- *    - SIGUSR1 pour bit 0
- * 
- * 3. Confirmation :
- *    - Attente active avec pause()
- *    - Vérification du drapeau g_signal_received
- * 
- * Gestion d'erreur robuste :
- * - Vérification de chaque appel système
- * - Messages d'erreur explicites
- * - Terminaison propre en cas d'échec
+ * @brief Détermine le mode de transport demandé sur la ligne de commande
+ * @param argc Nombre d'arguments
+ * @param argv Tableau des arguments
+ * @return 0 pour le mode bit par bit, 1 pour le mode temps réel (-r),
+ *         2 pour l'envoi d'un fichier (-f), 3 pour les blocs contrôlés
+ *         (-c), -1 si les arguments sont invalides
+ * 
+ * Formats acceptés :
+ * - ./client [pid] [message]      : SIGUSR1/SIGUSR2, un bit par signal
+ * - ./client [pid] [message] -r   : SIGRTMIN, 3 octets par signal
+ * - ./client [pid] [message] -c   : blocs de 64 octets et CRC32C,
+ *                                   un acquittement par bloc
+ * - ./client [pid] -f [path]      : contenu d'un fichier, "-" pour stdin
+ * 
+ * [pid] peut aussi être une liste "pid,pid,..." ou "@fichier" : le
+ * message part alors vers tous ces serveurs (mt_broadcast).
  */
-static void	ft_send_bit(pid_t pid, int bit_val)
+static int	ft_parse_mode(int argc, char **argv)
 {
-	g_signal_received = 0;
-	if (bit_val)
-	{
-		if (kill(pid, SIGUSR2) == -1)
-		{
-			write(2, "Error: Failed to send signal\n", 28);
-			exit(1);
-		}
-	}
-	else
-	{
-		if (kill(pid, SIGUSR1) == -1)
-		{
-			write(2, "Error: Failed to send signal\n", 28);
-			exit(1);
-		}
-	}
-	while (!g_signal_received)
-		pause();
+	if (argc == 4 && argv[2][0] == '-' && argv[2][1] == 'f' && !argv[2][2])
+		return (2);
+	if (argc == 3)
+		return (0);
+	if (argc == 4 && argv[3][0] == '-' && argv[3][1] == 'r' && !argv[3][2])
+		return (1);
+	if (argc == 4 && argv[3][0] == '-' && argv[3][1] == 'c' && !argv[3][2])
+		return (3);
+	return (-1);
 }
 
 /**
- * @brief Décompose et transmet un caractère
- * @param pid PID du serveur destinataire
- * @param c Caractère à transmettre
- * 
- * Processus de transmission détaillé :
- * 1. Décomposition du caractère en 8 bits
- * 2. Transmission MSB first (bit 7 à 0)
- * 3. Utilisation d'opérations bit à bit optimisées
- * 
- * Particularités techniques :
- * - Utilisation de unsigned char pour éviter les problèmes de signe
- * - Ordre de transmission standardisé (MSB first)
- * - Attente de confirmation pour chaque bit
+ * @brief Traduit le résultat d'un envoi en message et en code de sortie
+ * @param ret Code rendu par mt_send, mt_broadcast ou ft_send_file
+ * @param pid Serveur concerné lors d'une diffusion, 0 sinon
+ * @return 0 si le message est confirmé, 1 sinon
+ * 
+ * Lors d'une diffusion, chaque serveur a sa ligne "pid: résultat" sur
+ * la sortie standard, pour que le rapport reste lisible une fois
+ * redirigé ; seul le code de sortie signale un échec.
  */
-void	ft_send_char(pid_t pid, unsigned char c)
+static int	ft_report(int ret, pid_t pid)
 {
-	int	bit;
+	const char	*msg;
+	size_t		len;
 
-	bit = 7;
-	while (bit >= 0)
+	msg = "Error: Failed to send signal\n";
+	if (ret == MT_OK || ret == LINK_DONE)
+		msg = "Message received by server\n";
+	else if (ret == MT_ETIMEOUT)
+		msg = "Error: Server not responding\n";
+	else if (ret == MT_EFILE)
+		msg = "Error: Cannot read file\n";
+	else if (ret == MT_EINVAL)
+		msg = "Error: Invalid or duplicate PID\n";
+	len = 0;
+	while (msg[len])
+		len++;
+	if (pid > 0)
 	{
-		ft_send_bit(pid, (c >> bit) & 1);
-		bit--;
+		ft_putnbr(pid);
+		ft_out_write(": ", 2);
+		ft_out_write(msg, len);
 	}
+	else if (ret == MT_OK || ret == LINK_DONE)
+		write(1, msg, len);
+	else
+		write(2, msg, len);
+	return (ret != MT_OK && ret != LINK_DONE);
 }
 
 /**
- * @brief Orchestre la transmission complète d'un message
- * @param server_pid PID du serveur destinataire
- * @param message Message à transmettre
- * 
- * Protocole complet de transmission :
- * 1. Envoi séquentiel des caractères
- * 2. Transmission du caractère nul terminal
- * 3. Attente de la confirmation finale
- * 
- * Caractéristiques importantes :
- * - Transmission ordonnée et fiable
- * - Gestion de la fin de message
- * - Synchronisation bidirectionnelle
- * - Attente active économe (pause)
+ * @brief Envoie le message à un ou plusieurs serveurs
+ * @param dests Serveurs destinataires
+ * @param n     Nombre de serveurs
+ * @param argv  Arguments : argv[2] est le message, ou le fichier (-f)
+ * @param mode  Mode rendu par ft_parse_mode
+ * @return 0 si tous les serveurs ont confirmé, 1 sinon
+ * 
+ * Un seul serveur : mt_send, ou ft_send_file avec -f. Plusieurs :
+ * mt_broadcast, qui les sert tous en même temps depuis ce processus ;
+ * -f ne prend qu'un serveur, le fichier n'étant lu qu'une fois.
  */
-static void	ft_send_message(pid_t server_pid, char *message)
+static int	ft_dispatch(t_mt_dest *dests, int n, char **argv, int mode)
 {
-	int	i;
+	t_mt_opts	opts;
+	size_t		len;
+	int			ret;
+	int			i;
 
-	i = 0;
-	while (message[i])
+	if (mode == 2 && n == 1)
+		return (ft_report(ft_send_file(dests[0].pid, argv[3]), 0));
+	if (mode == 2)
 	{
-		ft_send_char(server_pid, message[i]);
-		i++;
+		write(2, "Error: -f takes a single PID\n", 29);
+		return (1);
 	}
-	ft_send_char(server_pid, '\0');
-	while (1)
-		pause();
+	opts.mode = MT_BIT;
+	opts.transport = MT_SIGNAL;
+	if (mode == 1)
+		opts.mode = MT_WORD;
+	else if (mode == 3)
+		opts.mode = MT_BLOCK;
+	len = 0;
+	while (argv[2][len])
+		len++;
+	if (n == 1)
+		return (ft_report(mt_send(dests[0].pid, argv[2], len, &opts), 0));
+	ret = mt_broadcast(dests, n, argv[2], &opts);
+	ft_out_init();
+	i = -1;
+	while (++i < n)
+		ft_report(dests[i].status, dests[i].pid);
+	ft_out_flush();
+	return (ret != MT_OK);
 }
 
 /**
@@ -193,51 +162,45 @@ static void	ft_send_message(pid_t server_pid, char *message)
  * @param argv Tableau des arguments
  * @return 0 en cas de succès, 1 en cas d'erreur
  * 
- * Séquence d'initialisation et d'exécution :
+ * Enveloppe de libminitalk :
  * 
  * 1. Validation des arguments :
- *    - Vérification du nombre d'arguments
- *    - Validation du PID serveur
- * 
- * 2. Configuration des signaux :
- *    - Initialisation de sigaction
- *    - Configuration des handlers
- *    - Vérification des erreurs
- * 
- * 3. Transmission du message :
- *    - Appel à ft_send_message
+ *    - Vérification du nombre d'arguments et des options -r, -c, -f
+ *    - Lecture des PID serveurs : un PID, une liste séparée par des
+ *      virgules, ou @fichier (ft_parse_pids)
+ * 
+ * 2. Transmission du message (ft_dispatch) :
+ *    - mt_send, bit par bit, par mots avec -r (MT_WORD) ou par blocs
+ *      avec -c (MT_BLOCK)
+ *    - mt_broadcast pour plusieurs serveurs à la fois
+ *    - Ou ft_send_file pour le contenu d'un fichier (-f)
  *    - Attente de la confirmation finale
  * 
  * Gestion d'erreur complète :
- * - Vérification de chaque étape
- * - Messages d'erreur explicites
+ * - La bibliothèque rend ses erreurs au lieu de terminer le programme
+ * - Messages d'erreur explicites (ft_report)
  * - Codes de retour appropriés
  */
 int	main(int argc, char **argv)
 {
-	struct sigaction	sa;
-	pid_t				server_pid;
+	t_mt_dest	*dests;
+	int			mode;
+	int			n;
 
-	if (argc != 3)
-	{
-		write(2, "Usage: ./client [server_pid] [message]\n", 38);
-		return (1);
-	}
-	server_pid = ft_atoi(argv[1]);
-	if (server_pid <= 0)
+	mode = ft_parse_mode(argc, argv);
+	if (mode < 0)
 	{
-		write(2, "Error: Invalid PID\n", 18);
+		write(2, "Usage: ./client [pid[,pid...] | @pid_file] "
+			"[message [-r | -c] | -f path]\n", 73);
 		return (1);
 	}
-	sa.sa_handler = ft_sig_handler;
-	sigemptyset(&sa.sa_mask);
-	sa.sa_flags = 0;
-	if (sigaction(SIGUSR1, &sa, NULL) == -1
-		|| sigaction(SIGUSR2, &sa, NULL) == -1)
+	n = ft_parse_pids(argv[1], &dests);
+	if (n <= 0)
 	{
-		write(2, "Error: sigaction failed\n", 23);
+		write(2, "Error: Invalid PID\n", 19);
 		return (1);
 	}
-	ft_send_message(server_pid, argv[2]);
-	return (0);
+	mode = ft_dispatch(dests, n, argv, mode);
+	free(dests);
+	return (mode);
 }
@@ -0,0 +1,167 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   client_fan.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fdi-tria <fdi-tria@student.42lausanne.c    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 12:18:52 by fdi-tria          #+#    #+#             */
+/*   Updated: 2026/10/16 14:36:20 by fdi-tria         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @brief Active sigqueue() et sigtimedwait()
+ * 
+ * Mêmes définitions que client_link.c.
+ */
+#define _POSIX_C_SOURCE 199309L
+#define _XOPEN_SOURCE 700
+#define _DEFAULT_SOURCE
+#include "minitalk.h"
+
+/**
+ * @brief Envoie (ou renvoie) l'unité en cours d'un destinataire
+ * @param d Destinataire dont l'envoi est en cours
+ * 
+ * Après LINK_RETX_MAX envois sans acquittement, le destinataire est
+ * abandonné (MT_ETIMEOUT) ; un signal qui ne peut pas partir, serveur
+ * disparu par exemple, l'abandonne aussitôt (MT_ESEND). Les autres
+ * destinataires continuent.
+ */
+static void	ft_fan_emit(t_dest *d)
+{
+	if (d->tries++ >= LINK_RETX_MAX)
+	{
+		d->out->status = MT_ETIMEOUT;
+		return ;
+	}
+	d->sent = ft_now();
+	if (ft_link_emit(&d->link, d->units, d->n, d->pack.kind) == -1)
+		d->out->status = MT_ESEND;
+}
+
+/**
+ * @brief Rend un acquittement à son destinataire et fait avancer celui-ci
+ * @param d    Tableau des destinataires
+ * @param n    Nombre de destinataires
+ * @param info Signal reçu : si_pid désigne le serveur, la valeur porte
+ *             le numéro de l'unité (~numéro pour un bloc rejeté)
+ * @return 1 si le destinataire vient de terminer, avec succès ou non,
+ *         0 sinon
+ * 
+ * Mêmes règles que ft_link_wait pour un seul serveur : un numéro
+ * périmé (doublon) est ignoré, un rejet fait renvoyer l'unité sans
+ * attendre l'échéance, et seule une unité acquittée du premier coup
+ * alimente la mesure du RTT (algorithme de Karn). RT_DONE termine le
+ * message de ce serveur ; sinon l'unité suivante part aussitôt.
+ */
+static int	ft_fan_ack(t_dest *d, size_t n, const siginfo_t *info)
+{
+	size_t	i;
+	int		value;
+
+	ft_trace_rec(TRACE_ACKED | info->si_signo, info->si_pid,
+		info->si_value.sival_int);
+	i = 0;
+	while (i < n && (d[i].link.pid != info->si_pid
+			|| d[i].out->status != MT_PENDING))
+		i++;
+	if (i == n)
+		return (0);
+	d = &d[i];
+	value = info->si_value.sival_int;
+	if (info->si_signo == SIGRTMIN + RT_ACK && value == ~d->link.seq)
+		ft_fan_emit(d);
+	if (value != d->link.seq)
+		return (d->out->status != MT_PENDING);
+	if (d->tries == 1)
+		ft_link_rtt(&d->link, ft_now() - d->sent);
+	d->link.seq++;
+	if (info->si_signo == SIGRTMIN + RT_DONE)
+	{
+		d->out->status = MT_OK;
+		return (1);
+	}
+	d->tries = 0;
+	d->n = ft_pack_unit(&d->pack, d->units);
+	ft_fan_emit(d);
+	return (d->out->status != MT_PENDING);
+}
+
+/**
+ * @brief Envoie les unités en attente et renvoie celles dont le délai
+ *        est écoulé
+ * @param d Tableau des destinataires
+ * @param n Nombre de destinataires
+ * @return Nombre de destinataires dont l'envoi est encore en cours
+ * 
+ * Appelée toutes les FAN_TICK_US au plus : le parcours de tous les
+ * destinataires ne se fait pas à chaque acquittement. Un délai expiré
+ * double le RTO du seul serveur concerné (ft_link_rtt).
+ */
+static size_t	ft_fan_poll(t_dest *d, size_t n)
+{
+	size_t	pending;
+	size_t	i;
+	long	now;
+
+	now = ft_now();
+	pending = 0;
+	i = -1;
+	while (++i < n)
+	{
+		if (d[i].out->status != MT_PENDING)
+			continue ;
+		if (d[i].tries && now - d[i].sent >= d[i].link.rto)
+			ft_link_rtt(&d[i].link, 0);
+		if (!d[i].tries || now - d[i].sent >= d[i].link.rto)
+			ft_fan_emit(&d[i]);
+		pending += (d[i].out->status == MT_PENDING);
+	}
+	return (pending);
+}
+
+/**
+ * @brief Pilote tous les destinataires d'une diffusion jusqu'à la fin
+ * @param d   Destinataires préparés, aucune unité encore envoyée
+ * @param n   Nombre de destinataires
+ * @param set Signaux d'acquittement, déjà bloqués (ft_link)
+ * @return MT_OK si tous les serveurs ont confirmé, sinon la première
+ *         erreur dans l'ordre des destinataires
+ * 
+ * Une seule attente sigtimedwait() pour tous les serveurs : les
+ * acquittements temps réel sont mis en file par le noyau, un par
+ * serveur, et chacun relance aussitôt l'envoi de son serveur. Le
+ * délai d'attente est d'un FAN_TICK_US, après lequel les échéances de
+ * retransmission sont examinées.
+ */
+int	ft_fan_run(t_dest *d, size_t n, const sigset_t *set)
+{
+	siginfo_t		info;
+	struct timespec	ts;
+	size_t			pending;
+	size_t			i;
+	long			scan;
+
+	ts.tv_sec = 0;
+	ts.tv_nsec = FAN_TICK_US * 1000L;
+	pending = ft_fan_poll(d, n);
+	scan = ft_now() + FAN_TICK_US * 1000L;
+	while (pending)
+	{
+		if (ft_transport()->wait_ack(set, &info, &ts) > 0)
+			pending -= ft_fan_ack(d, n, &info);
+		if (pending && ft_now() >= scan)
+		{
+			pending = ft_fan_poll(d, n);
+			scan = ft_now() + FAN_TICK_US * 1000L;
+		}
+	}
+	i = 0;
+	while (i < n && d[i].out->status == MT_OK)
+		i++;
+	if (i < n)
+		return (d[i].out->status);
+	return (MT_OK);
+}
@@ -0,0 +1,243 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   client_link.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fdi-tria <fdi-tria@student.42lausanne.c    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 06:52:33 by fdi-tria          #+#    #+#             */
+/*   Updated: 2026/10/16 14:36:20 by fdi-tria         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @brief Active sigqueue() et sigtimedwait()
+ * 
+ * Mêmes définitions que client.c : ces fonctions ne sont exposées
+ * qu'à partir de POSIX.1b (199309L).
+ */
+#define _POSIX_C_SOURCE 199309L
+#define _XOPEN_SOURCE 700
+#define _DEFAULT_SOURCE
+#include "minitalk.h"
+#include <errno.h>
+
+/**
+ * @brief Accès à l'état unique de la liaison
+ * @return La liaison, initialisée au premier appel, ou NULL si les
+ *         signaux n'ont pas pu être bloqués
+ * 
+ * SIGRTMIN + RT_ACK et SIGRTMIN + RT_DONE sont bloqués avant le premier
+ * envoi : les confirmations du serveur restent en attente jusqu'à ce
+ * que sigtimedwait() les retire, il n'y a plus de gestionnaire. Ils le
+ * restent ensuite dans le programme qui utilise la bibliothèque.
+ * 
+ * Le numéro de séquence n'est jamais remis à zéro : les messages
+ * successifs d'un même processus continuent la numérotation (voir
+ * mt_send). mt_broadcast part de ce même numéro pour chaque serveur.
+ * Le journal des signaux (MT_TRACE) est ouvert en même temps.
+ */
+t_link	*ft_link(void)
+{
+	static t_link	link;
+
+	if (link.rto)
+		return (&link);
+	sigemptyset(&link.set);
+	sigaddset(&link.set, SIGRTMIN + RT_ACK);
+	sigaddset(&link.set, SIGRTMIN + RT_DONE);
+	if (sigprocmask(SIG_BLOCK, &link.set, NULL) == -1)
+		return (NULL);
+	link.rto = LINK_RTO_INIT_US * 1000L;
+	ft_trace_init();
+	return (&link);
+}
+
+/**
+ * @brief Intègre une mesure de RTT et recalcule le délai de retransmission
+ * @param l   État de la liaison
+ * @param rtt Aller-retour mesuré, en nanosecondes, ou 0 si l'échéance
+ *            est passée sans acquittement
+ * 
+ * Estimateur de Jacobson/Karels : rttvar += (|srtt - rtt| - rttvar) / 4,
+ * srtt += (rtt - srtt) / 8, rto = srtt + 4 * rttvar. Le plancher
+ * LINK_RTO_MIN_US absorbe les retards d'ordonnancement ; une
+ * retransmission trop précoce n'est qu'un doublon que le serveur ignore.
+ * À l'échéance, le délai est doublé (plafonné à LINK_RTO_MAX_US) pour
+ * ne pas saturer un serveur ralenti.
+ */
+void	ft_link_rtt(t_link *l, long rtt)
+{
+	long	err;
+
+	if (rtt <= 0)
+		l->rto = 2 * l->rto;
+	else if (!l->srtt)
+	{
+		l->srtt = rtt;
+		l->rttvar = rtt / 2;
+	}
+	else
+	{
+		err = l->srtt - rtt;
+		if (err < 0)
+			err = -err;
+		l->rttvar += (err - l->rttvar) / 4;
+		l->srtt += (rtt - l->srtt) / 8;
+	}
+	if (rtt > 0)
+		l->rto = l->srtt + 4 * l->rttvar;
+	if (l->rto < LINK_RTO_MIN_US * 1000L)
+		l->rto = LINK_RTO_MIN_US * 1000L;
+	if (l->rto > LINK_RTO_MAX_US * 1000L)
+		l->rto = LINK_RTO_MAX_US * 1000L;
+}
+
+/**
+ * @brief Attend l'acquittement de l'unité en cours jusqu'à l'échéance
+ * @param l    État de la liaison
+ * @param sent Instant de l'envoi, en nanosecondes
+ * @return 1 si l'unité est acquittée, 2 si elle termine le message,
+ *         -1 si le serveur la rejette (bloc corrompu), 0 si le délai
+ *         rto est écoulé
+ * 
+ * Un acquittement portant un autre numéro (doublon d'une unité
+ * précédente) est ignoré et l'attente reprend pour le temps restant.
+ * Un rejet porte le complément du numéro (~seq) : l'unité est renvoyée
+ * sans attendre l'échéance.
+ * RT_DONE confirme la réception complète du message ; il porte lui
+ * aussi le numéro de la dernière unité, pour qu'une confirmation
+ * renvoyée en retard ne termine pas le message suivant. À l'échéance,
+ * le délai est doublé (ft_link_rtt). L'attente passe par le transport
+ * en cours : EAGAIN signifie que rien n'arrivera avant l'échéance.
+ */
+static int	ft_link_wait(t_link *l, long sent)
+{
+	siginfo_t		info;
+	struct timespec	ts;
+	long			left;
+	int				sig;
+
+	left = l->rto - (ft_now() - sent);
+	while (left > 0)
+	{
+		ts.tv_sec = left / 1000000000L;
+		ts.tv_nsec = left % 1000000000L;
+		sig = ft_transport()->wait_ack(&l->set, &info, &ts);
+		if (sig == -1 && errno == EAGAIN)
+			break ;
+		if (sig > 0)
+			ft_trace_rec(TRACE_ACKED | sig, info.si_pid,
+				info.si_value.sival_int);
+		if (sig == SIGRTMIN + RT_DONE && info.si_value.sival_int == l->seq)
+			return (2);
+		if (sig == SIGRTMIN + RT_ACK && info.si_value.sival_int == l->seq)
+			return (1);
+		if (sig == SIGRTMIN + RT_ACK && info.si_value.sival_int == ~l->seq)
+			return (-1);
+		left = l->rto - (ft_now() - sent);
+	}
+	ft_link_rtt(l, 0);
+	return (0);
+}
+
+/**
+ * @brief Émet les signaux d'une unité, sans attendre
+ * @param l     Liaison : serveur destinataire et numéro de l'unité
+ * @param units Bit, mot, ou mots du bloc suivis de son CRC32C
+ * @param n     Nombre de signaux à émettre
+ * @param mode  LINK_BIT, LINK_WORD ou LINK_BLOCK
+ * @return 0 en cas de succès, -1 si un envoi échoue
+ * 
+ * Chaque unité porte son numéro : dans la valeur de sigqueue() pour un
+ * bit, sur l'octet de poids fort pour un mot, mêlé par ou exclusif au
+ * CRC32C pour un bloc. Les mots d'un bloc partagent un même signal,
+ * délivré dans l'ordre d'envoi ; le CRC part sur un signal distinct :
+ * le serveur sait où le bloc se termine même si un mot s'est perdu en
+ * route. Les signaux partent par le transport en cours (sigqueue(),
+ * ou la boucle locale de MT_LOOPBACK).
+ */
+int	ft_link_emit(const t_link *l, const unsigned int *units, int n, int mode)
+{
+	t_transport	*t;
+	int			value;
+	int			sig;
+	int			i;
+
+	t = ft_transport();
+	i = -1;
+	while (++i < n)
+	{
+		value = l->seq;
+		sig = SIGUSR1;
+		if (mode == LINK_BIT && units[i])
+			sig = SIGUSR2;
+		else if (mode == LINK_WORD)
+		{
+			value = (l->seq & 0xFF) << 24 | (units[i] & 0xFFFFFF);
+			sig = SIGRTMIN;
+		}
+		else if (mode == LINK_BLOCK && i + 1 < n)
+		{
+			value = (int)units[i];
+			sig = SIGRTMIN + RT_BLOCK;
+		}
+		else if (mode == LINK_BLOCK)
+		{
+			value = (int)(units[i] ^ (unsigned int)l->seq);
+			sig = SIGRTMIN + RT_BLOCK_CRC;
+		}
+		ft_trace_rec(TRACE_SEND | sig, l->pid, value);
+		if (t->send_symbol(l->pid, sig, value) == -1)
+			return (-1);
+	}
+	return (0);
+}
+
+/**
+ * @brief Transmet une unité et attend son acquittement, avec reprise
+ * @param pid   PID du serveur destinataire
+ * @param units Bit (0 ou 1), mot de 32 bits, ou bloc et son CRC32C
+ * @param n     Nombre de signaux de l'unité (1, sauf pour un bloc)
+ * @param mode  LINK_BIT, LINK_WORD ou LINK_BLOCK
+ * @return LINK_ACKED, LINK_DONE si le serveur confirme la fin du
+ *         message, MT_ESEND si un signal ne peut pas partir, ou
+ *         MT_ETIMEOUT si le serveur ne répond plus
+ * 
+ * Faute d'acquittement dans le délai, ou sur rejet, l'unité est
+ * renvoyée ; le serveur reconnaît un doublon et se contente de
+ * l'acquitter de nouveau. Après LINK_RETX_MAX envois sans succès, le
+ * client abandonne au lieu d'attendre indéfiniment. Seules les unités
+ * acquittées du premier coup alimentent la mesure du RTT (algorithme
+ * de Karn). Les erreurs sont rendues à l'appelant : la bibliothèque ne
+ * termine jamais le programme qui l'utilise.
+ */
+int	ft_link_send(pid_t pid, const unsigned int *units, int n, int mode)
+{
+	t_link	*l;
+	int		tries;
+	int		acked;
+	long	sent;
+
+	l = ft_link();
+	if (!l)
+		return (MT_ESEND);
+	l->pid = pid;
+	tries = 0;
+	acked = 0;
+	while (acked < 1 && tries++ < LINK_RETX_MAX)
+	{
+		sent = ft_now();
+		if (ft_link_emit(l, units, n, mode) == -1)
+			return (MT_ESEND);
+		acked = ft_link_wait(l, sent);
+	}
+	if (acked < 1)
+		return (MT_ETIMEOUT);
+	if (tries == 1)
+		ft_link_rtt(l, ft_now() - sent);
+	l->seq++;
+	if (acked == 2)
+		return (LINK_DONE);
+	return (LINK_ACKED);
+}
@@ -0,0 +1,148 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   client_pids.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fdi-tria <fdi-tria@student.42lausanne.c    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 12:44:30 by fdi-tria          #+#    #+#             */
+/*   Updated: 2026/10/16 12:58:12 by fdi-tria         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @brief Active les extensions POSIX utilisées par minitalk.h
+ */
+#define _POSIX_C_SOURCE 199309L
+#define _XOPEN_SOURCE 700
+#define _DEFAULT_SOURCE
+#include "minitalk.h"
+#include <fcntl.h>
+
+/**
+ * @brief Double la taille d'un tampon de lecture
+ * @param buf Tampon courant, libéré par la fonction
+ * @param len Octets occupés, recopiés
+ * @param cap Taille courante, doublée en cas de succès
+ * @return Le nouveau tampon, ou NULL si l'allocation échoue
+ */
+static char	*ft_grow(char *buf, size_t len, size_t *cap)
+{
+	char	*grown;
+	size_t	i;
+
+	grown = malloc(*cap * 2);
+	i = -1;
+	while (grown && ++i < len)
+		grown[i] = buf[i];
+	free(buf);
+	*cap *= 2;
+	return (grown);
+}
+
+/**
+ * @brief Lit un fichier de PID en entier
+ * @param path Chemin du fichier, "-" pour l'entrée standard
+ * @return Contenu terminé par '\0', à libérer, ou NULL en cas d'erreur
+ */
+static char	*ft_read_all(const char *path)
+{
+	char	*buf;
+	size_t	cap;
+	size_t	len;
+	ssize_t	n;
+	int		fd;
+
+	fd = 0;
+	if (path[0] != '-' || path[1])
+		fd = open(path, O_RDONLY);
+	if (fd == -1)
+		return (NULL);
+	cap = 256;
+	len = 0;
+	buf = malloc(cap);
+	n = 1;
+	while (buf && n > 0)
+	{
+		if (len + 1 == cap)
+			buf = ft_grow(buf, len, &cap);
+		if (buf)
+			n = read(fd, buf + len, cap - len - 1);
+		if (buf && n > 0)
+			len += n;
+	}
+	if (fd)
+		close(fd);
+	if (!buf || n < 0)
+	{
+		free(buf);
+		return (NULL);
+	}
+	buf[len] = '\0';
+	return (buf);
+}
+
+/**
+ * @brief Parcourt une liste de PID séparés par des virgules ou des blancs
+ * @param s   Liste à parcourir
+ * @param out Destinataires à remplir, ou NULL pour seulement compter
+ * @return Nombre de PID, ou -1 si un élément n'est pas un PID valide
+ */
+static int	ft_scan(const char *s, t_mt_dest *out)
+{
+	long	pid;
+	int		n;
+
+	n = 0;
+	while (*s)
+	{
+		if (*s == ',' || *s == ' ' || (*s >= '\t' && *s <= '\r'))
+		{
+			s++;
+			continue ;
+		}
+		pid = 0;
+		while (*s >= '0' && *s <= '9' && pid <= 0x7FFFFFFF)
+			pid = pid * 10 + (*s++ - '0');
+		if (pid <= 0 || pid > 0x7FFFFFFF
+			|| (*s && *s != ',' && *s != ' ' && (*s < '\t' || *s > '\r')))
+			return (-1);
+		if (out)
+			out[n].pid = pid;
+		n++;
+	}
+	return (n);
+}
+
+/**
+ * @brief Lit les serveurs destinataires du client
+ * @param arg   "pid", "pid,pid,..." ou "@fichier" (un PID par ligne ou
+ *              séparés par des virgules ou des blancs, "@-" pour stdin)
+ * @param dests Reçoit le tableau des destinataires, à libérer
+ * @return Nombre de destinataires, ou -1 si la liste est vide ou
+ *         invalide, ou si le fichier ne peut pas être lu
+ */
+int	ft_parse_pids(const char *arg, t_mt_dest **dests)
+{
+	char	*file;
+	int		n;
+
+	file = NULL;
+	if (arg[0] == '@')
+	{
+		file = ft_read_all(arg + 1);
+		if (!file)
+			return (-1);
+		arg = file;
+	}
+	*dests = NULL;
+	n = ft_scan(arg, NULL);
+	if (n > 0)
+		*dests = malloc(sizeof(t_mt_dest) * n);
+	if (*dests)
+		ft_scan(arg, *dests);
+	free(file);
+	if (!*dests)
+		return (-1);
+	return (n);
+}
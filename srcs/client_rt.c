@@ -0,0 +1,205 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   client_rt.c                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fdi-tria <fdi-tria@student.42lausanne.c    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 04:50:38 by fdi-tria          #+#    #+#             */
+/*   Updated: 2026/10/16 13:04:26 by fdi-tria         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @brief Active sigqueue() et les signaux temps réel (SIGRTMIN)
+ * 
+ * Mêmes définitions que client.c : sigqueue et union sigval ne sont
+ * exposés par <signal.h> qu'à partir de POSIX.1b (199309L).
+ */
+#define _POSIX_C_SOURCE 199309L
+#define _XOPEN_SOURCE 700
+#define _DEFAULT_SOURCE
+#include "minitalk.h"
+
+/**
+ * @brief Décompose et transmet un caractère
+ * @param pid PID du serveur destinataire
+ * @param c Caractère à transmettre
+ * @return Résultat de ft_link_send pour le dernier bit envoyé
+ * 
+ * Processus de transmission détaillé :
+ * 1. Décomposition du caractère en 8 bits
+ * 2. Transmission MSB first (bit 7 à 0)
+ * 3. Utilisation d'opérations bit à bit optimisées
+ * 
+ * Particularités techniques :
+ * - Utilisation de unsigned char pour éviter les problèmes de signe
+ * - Ordre de transmission standardisé (MSB first)
+ * - Attente de confirmation pour chaque bit, avec retransmission
+ *   (ft_link_send) si elle n'arrive pas à temps
+ * - Arrêt au premier bit non acquitté
+ */
+int	ft_send_char(pid_t pid, unsigned char c)
+{
+	unsigned int	value;
+	int				bit;
+	int				ret;
+
+	bit = 7;
+	ret = LINK_ACKED;
+	while (bit >= 0 && ret == LINK_ACKED)
+	{
+		value = (c >> bit) & 1;
+		ret = ft_link_send(pid, &value, 1, LINK_BIT);
+		bit--;
+	}
+	return (ret);
+}
+
+/**
+ * @brief Regroupe jusqu'à size octets du message dans un mot
+ * @param p    Découpage en cours : position avancée, done passe à 1 dès
+ *             que le '\0' terminal a été empaqueté
+ * @param size 3 pour un mot de -r (l'octet de poids fort reçoit le
+ *             numéro de séquence), 4 pour un mot de bloc
+ * @return Le mot construit, premier octet dans les bits de poids fort
+ *         des size octets
+ * 
+ * L'ordre MSB first est conservé pour rester cohérent avec le mode
+ * bit par bit. Le '\0' terminal est ajouté à la position len ; une
+ * fois placé, les octets restants du mot sont complétés par des zéros
+ * que le serveur ignore.
+ */
+static unsigned int	ft_pack_word(t_pack *p, int size)
+{
+	unsigned int	word;
+	int				n;
+
+	word = 0;
+	n = 0;
+	while (n < size)
+	{
+		word = word << 8;
+		if (!p->done)
+		{
+			if (p->i < p->len)
+				word = word | (unsigned char)p->buf[p->i];
+			else
+				p->done = 1;
+			p->i++;
+		}
+		n++;
+	}
+	return (word);
+}
+
+/**
+ * @brief Prépare le découpage d'un message
+ * @param p    Découpage à initialiser
+ * @param buf  Message à transmettre
+ * @param len  Longueur du message, '\0' terminal exclu
+ * @param mode LINK_BIT, LINK_WORD (-r) ou LINK_BLOCK (-c)
+ * 
+ * En mode bit par bit, tout le message fait partie des octets de tête
+ * (lead), '\0' compris. L'appelant peut demander un premier octet bit
+ * par bit dans les autres modes en mettant lead à 1 (voir mt_send).
+ */
+void	ft_pack_init(t_pack *p, const char *buf, size_t len, int mode)
+{
+	p->buf = buf;
+	p->len = len;
+	p->i = 0;
+	p->lead = 0;
+	if (mode == LINK_BIT)
+		p->lead = len + 1;
+	p->bit = 0;
+	p->done = 0;
+	p->mode = mode;
+	p->kind = mode;
+	if (mode == LINK_BLOCK)
+		ft_crc32c_init();
+}
+
+/**
+ * @brief Découpe l'unité suivante du message
+ * @param p     Découpage en cours
+ * @param units Reçoit le bit, le mot, ou les mots du bloc suivis de
+ *              son CRC32C
+ * @return Nombre de signaux de l'unité, 0 si le message est épuisé ;
+ *         p->kind indique le mode de l'unité pour ft_link_emit
+ * 
+ * Un mot de -r regroupe 3 octets : un message de n caractères coûte
+ * (n + 1) / 3 signaux arrondis au supérieur, soit 24 fois moins qu'en
+ * mode bit par bit. Un bloc regroupe BLOCK_WORDS mots de 4 octets
+ * (BLOCK_BYTES octets, le dernier bloc complété par des zéros) suivis
+ * du CRC32C des octets du bloc, dans l'ordre où le serveur les
+ * reconstruit : 17 signaux aller et 1 retour pour 64 octets, contre
+ * 512 et 512 en mode bit par bit. Le '\0' terminal fait partie de la
+ * dernière unité.
+ */
+int	ft_pack_unit(t_pack *p, unsigned int *units)
+{
+	unsigned char	bytes[BLOCK_BYTES];
+	int				k;
+
+	if (p->done)
+		return (0);
+	p->kind = LINK_BIT;
+	if (p->lead)
+	{
+		units[0] = 0;
+		if (p->i < p->len)
+			units[0] = ((unsigned char)p->buf[p->i] >> (7 - p->bit)) & 1;
+		if (++p->bit == 8)
+		{
+			p->bit = 0;
+			p->lead--;
+			p->done = (p->i++ == p->len);
+		}
+		return (1);
+	}
+	p->kind = p->mode;
+	if (p->mode == LINK_WORD)
+	{
+		units[0] = ft_pack_word(p, 3);
+		return (1);
+	}
+	k = -1;
+	while (++k < BLOCK_WORDS)
+		units[k] = ft_pack_word(p, 4);
+	k = -1;
+	while (++k < BLOCK_BYTES)
+		bytes[k] = units[k / 4] >> (24 - 8 * (k % 4));
+	units[BLOCK_WORDS] = ft_crc32c(bytes, BLOCK_BYTES);
+	return (BLOCK_WORDS + 1);
+}
+
+/**
+ * @brief Transmet un message découpé, unité par unité
+ * @param pid PID du serveur destinataire
+ * @param p   Découpage préparé par ft_pack_init
+ * @return LINK_DONE une fois le message confirmé, ou l'erreur de
+ *         ft_link_send
+ * 
+ * Contrairement à kill(), sigqueue() attache le mot au signal et les
+ * signaux temps réel sont mis en file au lieu d'être fusionnés. Le
+ * numéro de séquence est ajouté par ft_link_send ; le serveur
+ * n'acquitte qu'une fois par unité, ou rejette un bloc dont le CRC ne
+ * correspond pas.
+ */
+int	ft_send_units(pid_t pid, t_pack *p)
+{
+	unsigned int	units[BLOCK_WORDS + 1];
+	int				n;
+	int				ret;
+
+	ret = LINK_ACKED;
+	n = ft_pack_unit(p, units);
+	while (n && ret == LINK_ACKED)
+	{
+		ret = ft_link_send(pid, units, n, p->kind);
+		if (ret == LINK_ACKED)
+			n = ft_pack_unit(p, units);
+	}
+	return (ret);
+}
@@ -0,0 +1,129 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   client_stream.c                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fdi-tria <fdi-tria@student.42lausanne.c    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 06:11:45 by fdi-tria          #+#    #+#             */
+/*   Updated: 2026/10/16 12:09:41 by fdi-tria         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @brief Active aio_read() et les définitions POSIX nécessaires
+ * 
+ * Mêmes définitions que client.c : struct aiocb et aio_suspend() ne
+ * sont exposés qu'à partir de POSIX.1b (199309L).
+ */
+#define _POSIX_C_SOURCE 199309L
+#define _XOPEN_SOURCE 700
+#define _DEFAULT_SOURCE
+#include "minitalk.h"
+#include <errno.h>
+#include <fcntl.h>
+
+/**
+ * @brief Lance la lecture du prochain morceau dans le tampon courant
+ * @param st État de la lecture
+ * @return 1 si la lecture est lancée, 0 en cas d'erreur
+ * 
+ * aio_read() rend la main immédiatement : glibc lit depuis un thread
+ * auxiliaire qui bloque tous les signaux, les confirmations du serveur
+ * continuent donc d'arriver au thread principal.
+ */
+static int	ft_stream_read(t_stream *st)
+{
+	st->cb.aio_fildes = st->fd;
+	st->cb.aio_buf = st->buf[st->cur];
+	st->cb.aio_nbytes = STREAM_CHUNK;
+	st->cb.aio_offset = st->off;
+	st->cb.aio_sigevent.sigev_notify = SIGEV_NONE;
+	return (aio_read(&st->cb) == 0);
+}
+
+/**
+ * @brief Ouvre le fichier à envoyer et lance la première lecture
+ * @param st   État de la lecture
+ * @param path Chemin du fichier, "-" pour l'entrée standard
+ * @return 1 en cas de succès, 0 si le fichier est illisible
+ */
+int	ft_stream_open(t_stream *st, const char *path)
+{
+	st->fd = 0;
+	if (path[0] != '-' || path[1])
+		st->fd = open(path, O_RDONLY);
+	st->cur = 0;
+	st->off = 0;
+	return (st->fd != -1 && ft_stream_read(st));
+}
+
+/**
+ * @brief Attend le morceau en cours de lecture et lance le suivant
+ * @param st   État de la lecture
+ * @param data Reçoit l'adresse du morceau lu
+ * @return Taille du morceau, 0 en fin de fichier, -1 en cas d'erreur
+ * 
+ * aio_suspend() peut être interrompu par un signal : l'attente reprend
+ * tant que la lecture est en cours.
+ */
+ssize_t	ft_stream_next(t_stream *st, const unsigned char **data)
+{
+	const struct aiocb	*list[1];
+	ssize_t				n;
+
+	list[0] = &st->cb;
+	while (aio_error(&st->cb) == EINPROGRESS)
+		aio_suspend(list, 1, NULL);
+	n = aio_return(&st->cb);
+	if (n <= 0)
+		return (n);
+	*data = st->buf[st->cur];
+	st->off += n;
+	st->cur = !st->cur;
+	if (!ft_stream_read(st))
+		return (-1);
+	return (n);
+}
+
+/**
+ * @brief Transmet le contenu d'un fichier ou de l'entrée standard (-f)
+ * @param pid  PID du serveur destinataire
+ * @param path Chemin du fichier, "-" pour l'entrée standard
+ * @return LINK_DONE une fois le message confirmé, MT_EFILE si le
+ *         fichier est illisible, ou l'erreur de ft_link_send
+ * 
+ * Le fichier n'est jamais chargé en entier : chaque morceau part bit
+ * par bit pendant que le suivant est lu. Le protocole de base termine
+ * un message par '\0' : les octets nuls du fichier sont donc ignorés,
+ * ce mode est réservé au texte (client_bonus -f transmet le binaire).
+ */
+int	ft_send_file(pid_t pid, const char *path)
+{
+	static t_stream		st;
+	const unsigned char	*data;
+	ssize_t				n;
+	ssize_t				i;
+	int					ret;
+
+	if (!ft_stream_open(&st, path))
+		return (MT_EFILE);
+	ret = LINK_ACKED;
+	n = ft_stream_next(&st, &data);
+	while (n > 0 && ret == LINK_ACKED)
+	{
+		i = 0;
+		while (i < n && ret == LINK_ACKED)
+		{
+			if (data[i])
+				ret = ft_send_char(pid, data[i]);
+			i++;
+		}
+		n = ft_stream_next(&st, &data);
+	}
+	if (ret != LINK_ACKED)
+		return (ret);
+	if (n < 0)
+		return (MT_EFILE);
+	return (ft_send_char(pid, '\0'));
+}
@@ -0,0 +1,110 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   codec_bench.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fdi-tria <fdi-tria@student.42lausanne.c    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 14:31:47 by fdi-tria          #+#    #+#             */
+/*   Updated: 2026/10/16 14:31:47 by fdi-tria         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/* Définition des standards POSIX pour les signaux temps réel */
+#define _POSIX_C_SOURCE 199309L
+#define _XOPEN_SOURCE 700
+#define _DEFAULT_SOURCE
+#include "minitalk.h"
+
+/**
+ * @brief Accès au message de référence de la mesure
+ * @return État unique, rempli par mt-codec avant la première passe
+ */
+t_codec	*ft_codec(void)
+{
+	static t_codec	codec;
+
+	return (&codec);
+}
+
+/**
+ * @brief Reçoit un message décodé par la boucle locale
+ * @param pid Client émetteur, le processus lui-même
+ * @param msg Octets décodés
+ * @param len Nombre d'octets
+ *
+ * Chaque message est comparé au message envoyé : une mesure n'a de
+ * sens que si le décodeur rend exactement ce que le codeur a reçu.
+ */
+static void	ft_codec_hook(pid_t pid, const char *msg, size_t len)
+{
+	t_codec	*c;
+	size_t	i;
+
+	(void)pid;
+	c = ft_codec();
+	i = 0;
+	while (i < len && len == c->len && msg[i] == c->src[i])
+		i++;
+	if (len == c->len && i == len)
+		c->good++;
+}
+
+/**
+ * @brief Découpe le message CODEC_PASSES fois sans rien émettre
+ * @param mode    MT_BIT, MT_WORD ou MT_BLOCK
+ * @param signals Reçoit le nombre de signaux produits
+ * @return Durée totale, en nanosecondes
+ *
+ * Même découpage que mt_send, octet de tête compris à partir de la
+ * deuxième passe : seul le codeur est mesuré (bits, mots, CRC32C des
+ * blocs), sans acquittement ni transport.
+ */
+long	ft_codec_encode(int mode, uint64_t *signals)
+{
+	unsigned int	units[BLOCK_WORDS + 1];
+	t_pack			p;
+	long			start;
+	int				pass;
+
+	*signals = 0;
+	start = ft_now();
+	pass = -1;
+	while (++pass < CODEC_PASSES)
+	{
+		ft_pack_init(&p, ft_codec()->src, ft_codec()->len, mode);
+		if (pass && mode != MT_BIT)
+			p.lead = 1;
+		*signals += ft_pack_unit(&p, units);
+		while (!p.done)
+			*signals += ft_pack_unit(&p, units);
+	}
+	return (ft_now() - start);
+}
+
+/**
+ * @brief Envoie le message CODEC_PASSES fois par la boucle locale
+ * @param mode MT_BIT, MT_WORD ou MT_BLOCK
+ * @return Durée totale, en nanosecondes
+ *
+ * Protocole entier sans noyau (MT_LOOPBACK) : codeur, liaison et ses
+ * acquittements, décodeur du serveur, qui remet chaque message à
+ * ft_codec_hook au lieu de l'afficher. Les passes s'arrêtent au
+ * premier message non confirmé.
+ */
+long	ft_codec_loop(int mode)
+{
+	t_mt_opts	opts;
+	long		start;
+	int			pass;
+
+	ft_msg()->hook = ft_codec_hook;
+	opts.mode = mode;
+	opts.transport = MT_LOOPBACK;
+	start = ft_now();
+	pass = 0;
+	while (pass++ < CODEC_PASSES
+		&& mt_send(getpid(), ft_codec()->src, ft_codec()->len, &opts) == MT_OK)
+		;
+	return (ft_now() - start);
+}
@@ -0,0 +1,144 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   crc32c.c                                           :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fdi-tria <fdi-tria@student.42lausanne.c    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 07:38:27 by fdi-tria          #+#    #+#             */
+/*   Updated: 2026/10/16 07:52:41 by fdi-tria         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "minitalk.h"
+
+/**
+ * @brief Accès aux tables du calcul logiciel et au choix matériel
+ * @return L'état unique du module
+ */
+static t_crc	*ft_crc(void)
+{
+	static t_crc	crc;
+
+	return (&crc);
+}
+
+/**
+ * @brief Prépare le calcul du CRC32C, une fois au démarrage
+ * 
+ * Les 8 tables du découpage par 8 octets sont construites ici, hors
+ * de tout gestionnaire de signaux : ft_crc32c est ensuite appelé par
+ * le serveur en plein gestionnaire, sans allocation ni initialisation
+ * paresseuse. table[k][n] est le CRC de l'octet n suivi de k octets
+ * nuls (polynôme de Castagnoli réfléchi, 0x82F63B78).
+ */
+void	ft_crc32c_init(void)
+{
+	t_crc		*c;
+	uint32_t	v;
+	int			n;
+	int			k;
+
+	c = ft_crc();
+	n = -1;
+	while (++n < 256)
+	{
+		v = n;
+		k = -1;
+		while (++k < 8)
+			v = (v >> 1) ^ (CRC32C_POLY & (0 - (v & 1)));
+		c->table[0][n] = v;
+	}
+	n = -1;
+	while (++n < 256)
+	{
+		k = 0;
+		while (++k < 8)
+			c->table[k][n] = (c->table[k - 1][n] >> 8)
+				^ c->table[0][c->table[k - 1][n] & 0xFF];
+	}
+	c->hw = 0;
+#if defined(__x86_64__)
+	c->hw = __builtin_cpu_supports("sse4.2");
+#endif
+}
+
+/**
+ * @brief CRC32C logiciel, 8 octets par itération (slicing-by-8)
+ * @param t   Tables préparées par ft_crc32c_init
+ * @param crc Valeur courante (inversée)
+ * @param p   Octets à intégrer
+ * @param len Nombre d'octets
+ * @return Nouvelle valeur courante
+ * 
+ * Les octets sont lus un à un : le résultat ne dépend ni de
+ * l'alignement ni de l'ordre des octets de la machine.
+ */
+static uint32_t	ft_crc32c_sw(uint32_t t[8][256], uint32_t crc,
+					const unsigned char *p, size_t len)
+{
+	uint32_t	hi;
+
+	while (len >= 8)
+	{
+		crc ^= p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16
+			| (uint32_t)p[3] << 24;
+		hi = p[4] | (uint32_t)p[5] << 8 | (uint32_t)p[6] << 16
+			| (uint32_t)p[7] << 24;
+		crc = t[7][crc & 0xFF] ^ t[6][(crc >> 8) & 0xFF]
+			^ t[5][(crc >> 16) & 0xFF] ^ t[4][crc >> 24]
+			^ t[3][hi & 0xFF] ^ t[2][(hi >> 8) & 0xFF]
+			^ t[1][(hi >> 16) & 0xFF] ^ t[0][hi >> 24];
+		p += 8;
+		len -= 8;
+	}
+	while (len--)
+		crc = t[0][(crc ^ *p++) & 0xFF] ^ (crc >> 8);
+	return (crc);
+}
+
+#if defined(__x86_64__)
+
+/**
+ * @brief CRC32C par l'instruction crc32 de SSE4.2
+ * 
+ * Même polynôme que ft_crc32c_sw : une instruction par 8 octets. La
+ * fonction n'est compilée pour SSE4.2 qu'elle-même, le reste du
+ * programme reste exécutable sur tout x86-64 ; ft_crc32c ne l'appelle
+ * que si le processeur l'annonce.
+ */
+__attribute__((target("sse4.2")))
+static uint32_t	ft_crc32c_hw(uint32_t crc, const unsigned char *p, size_t len)
+{
+	uint64_t	v;
+
+	while (len >= 8)
+	{
+		__builtin_memcpy(&v, p, 8);
+		crc = (uint32_t)__builtin_ia32_crc32di(crc, v);
+		p += 8;
+		len -= 8;
+	}
+	while (len--)
+		crc = __builtin_ia32_crc32qi(crc, *p++);
+	return (crc);
+}
+#endif
+
+/**
+ * @brief CRC32C (Castagnoli) d'un bloc d'octets
+ * @param buf Octets à contrôler
+ * @param len Nombre d'octets
+ * @return Le CRC, identique quelle que soit la voie de calcul
+ */
+uint32_t	ft_crc32c(const void *buf, size_t len)
+{
+	t_crc	*c;
+
+	c = ft_crc();
+#if defined(__x86_64__)
+	if (c->hw)
+		return (~ft_crc32c_hw(~0U, buf, len));
+#endif
+	return (~ft_crc32c_sw(c->table, ~0U, buf, len));
+}
@@ -0,0 +1,190 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   mt_client.c                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fdi-tria <fdi-tria@student.42lausanne.c    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 11:21:44 by fdi-tria          #+#    #+#             */
+/*   Updated: 2026/10/16 14:36:20 by fdi-tria         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @brief Active sigqueue() et les signaux temps réel
+ * 
+ * Mêmes définitions que client.c : la bibliothèque s'appuie sur les
+ * mêmes fonctions POSIX.1b.
+ */
+#define _POSIX_C_SOURCE 199309L
+#define _XOPEN_SOURCE 700
+#define _DEFAULT_SOURCE
+#include "minitalk.h"
+
+/**
+ * @brief Vérifie qu'un message ne contient aucun octet nul
+ * @param msg Octets du message
+ * @param len Nombre d'octets
+ * @return 1 si le message est transmissible, 0 sinon
+ */
+static int	ft_valid(const char *msg, size_t len)
+{
+	size_t	i;
+
+	if (!msg && len)
+		return (0);
+	i = 0;
+	while (i < len && msg[i])
+		i++;
+	return (i == len);
+}
+
+/**
+ * @brief Envoie un message au serveur et attend sa confirmation
+ * @param pid  PID du serveur destinataire
+ * @param buf  Octets du message, sans '\0' : le protocole s'en sert
+ *             comme fin de message
+ * @param len  Nombre d'octets
+ * @param opts Découpage (MT_BIT, MT_WORD, MT_BLOCK) et transport
+ *             (MT_SIGNAL, MT_LOOPBACK), NULL pour MT_BIT par signaux
+ * @return MT_OK si le serveur a confirmé le message entier, MT_EINVAL,
+ *         MT_ESEND ou MT_ETIMEOUT sinon
+ * 
+ * Le serveur reconnaît un doublon de la dernière unité du client
+ * précédent à son numéro ; un même processus qui enchaîne les messages
+ * ne repart donc pas de zéro, ce qui rendrait le premier bloc ou le
+ * premier mot du message suivant indiscernable d'une retransmission.
+ * La numérotation continue, et à partir du deuxième message le premier
+ * octet part bit par bit : un bit porte son numéro entier, que le
+ * serveur adopte pour le reste du message (ft_server_signal). Le
+ * premier message d'un processus est identique à celui de ./client.
+ * 
+ * Avec MT_LOOPBACK, pid n'est qu'une étiquette : le message est décodé
+ * dans le processus appelant par le décodeur du serveur, affiché sur
+ * la sortie standard ou remis au rappel installé dans ft_msg().
+ */
+int	mt_send(pid_t pid, const void *buf, size_t len, const t_mt_opts *opts)
+{
+	t_link	*l;
+	t_pack	p;
+	int		mode;
+	int		transport;
+	int		ret;
+
+	mode = MT_BIT;
+	transport = MT_SIGNAL;
+	if (opts)
+	{
+		mode = opts->mode;
+		transport = opts->transport;
+	}
+	if (pid <= 0 || !ft_valid(buf, len) || mode < MT_BIT || mode > MT_BLOCK
+		|| ft_transport_use(transport) == -1)
+		return (MT_EINVAL);
+	l = ft_link();
+	if (!l)
+		return (MT_ESEND);
+	ft_pack_init(&p, buf, len, mode);
+	if (l->msgs++ && mode != MT_BIT)
+		p.lead = 1;
+	ret = ft_send_units(pid, &p);
+	if (ret == LINK_DONE)
+		return (MT_OK);
+	return (ret);
+}
+
+/**
+ * @brief Prépare un destinataire de diffusion à partir de la liaison
+ * @param d    Destinataire à initialiser
+ * @param out  PID du serveur, et emplacement de son résultat
+ * @param p    Découpage du message, identique pour tous
+ * @param l    Liaison du processus : numéro de départ et délai initial
+ * 
+ * Chaque serveur reçoit le même flux d'unités, numérotées à partir du
+ * numéro courant du processus, et son propre estimateur de RTT.
+ */
+static void	ft_dest_init(t_dest *d, t_mt_dest *out, const t_pack *p,
+		const t_link *l)
+{
+	d->link = *l;
+	d->link.pid = out->pid;
+	d->pack = *p;
+	d->out = out;
+	d->tries = 0;
+	d->n = ft_pack_unit(&d->pack, d->units);
+	out->status = MT_PENDING;
+	if (out->pid <= 0)
+		out->status = MT_EINVAL;
+}
+
+/**
+ * @brief Envoie un même message à plusieurs serveurs en parallèle
+ * @param dests PID des serveurs ; status reçoit le résultat de chacun
+ * @param n     Nombre de serveurs
+ * @param msg   Message, terminé par '\0'
+ * @param opts  Découpage (MT_BIT, MT_WORD, MT_BLOCK), transport
+ *              MT_SIGNAL ; NULL pour MT_BIT
+ * @return MT_OK si tous les serveurs ont confirmé le message, sinon la
+ *         première erreur dans l'ordre de dests (détail dans
+ *         dests[i].status), ou MT_ENOMEM
+ * 
+ * Un seul processus pilote tous les envois : chaque serveur a sa
+ * propre unité en vol, et l'acquittement reçu est rendu à son serveur
+ * d'après son si_pid (ft_fan_run). Un serveur lent ne retient pas les
+ * autres ; la durée totale est celle du serveur le plus lent plutôt
+ * que la somme des envois.
+ * 
+ * Un PID invalide ou répété est rejeté (MT_EINVAL) sans retenir les
+ * autres : deux envois vers un même serveur seraient entrelacés. La
+ * numérotation du processus reprend ensuite après le plus grand numéro
+ * atteint. La diffusion passe toujours par les signaux du noyau : la
+ * boucle locale (MT_LOOPBACK) n'a qu'un décodeur, donc un seul
+ * serveur.
+ */
+int	mt_broadcast(t_mt_dest *dests, size_t n, const char *msg,
+		const t_mt_opts *opts)
+{
+	t_dest	*d;
+	t_link	*l;
+	t_pack	p;
+	size_t	i;
+	size_t	k;
+	int		ret;
+
+	if (!dests || !msg || (opts && (opts->mode < MT_BIT
+				|| opts->mode > MT_BLOCK || opts->transport != MT_SIGNAL)))
+		return (MT_EINVAL);
+	ft_transport_use(MT_SIGNAL);
+	l = ft_link();
+	if (!l)
+		return (MT_ESEND);
+	if (!n)
+		return (MT_OK);
+	d = malloc(sizeof(t_dest) * n);
+	if (!d)
+		return (MT_ENOMEM);
+	i = 0;
+	while (msg[i])
+		i++;
+	ft_pack_init(&p, msg, i, MT_BIT);
+	if (opts)
+		ft_pack_init(&p, msg, i, opts->mode);
+	if (l->msgs++ && p.mode != MT_BIT)
+		p.lead = 1;
+	i = -1;
+	while (++i < n)
+	{
+		ft_dest_init(&d[i], &dests[i], &p, l);
+		k = 0;
+		while (k < i && dests[k].pid != dests[i].pid)
+			k++;
+		if (k < i)
+			dests[i].status = MT_EINVAL;
+	}
+	ret = ft_fan_run(d, n, &l->set);
+	while (i--)
+		if (d[i].link.seq > l->seq)
+			l->seq = d[i].link.seq;
+	free(d);
+	return (ret);
+}
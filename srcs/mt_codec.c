@@ -0,0 +1,124 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   mt_codec.c                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fdi-tria <fdi-tria@student.42lausanne.c    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 14:31:47 by fdi-tria          #+#    #+#             */
+/*   Updated: 2026/10/16 14:31:47 by fdi-tria         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/* Définition des standards POSIX pour les signaux temps réel */
+#define _POSIX_C_SOURCE 199309L
+#define _XOPEN_SOURCE 700
+#define _DEFAULT_SOURCE
+#include "minitalk.h"
+
+/**
+ * @brief Affiche une ligne de mesure
+ * @param label   Étape mesurée, alignée par l'appelant
+ * @param signals Signaux produits ou décodés
+ * @param elapsed Durée totale, en nanosecondes
+ *
+ * Débit en octets de message par seconde, arrondi au centième de
+ * Mo/s, et coût moyen d'un signal.
+ */
+static void	ft_codec_print(const char *label, uint64_t signals, long elapsed)
+{
+	uint64_t	bytes;
+	uint64_t	rate;
+
+	if (elapsed < 1)
+		elapsed = 1;
+	if (!signals)
+		signals = 1;
+	bytes = (uint64_t)ft_codec()->len * CODEC_PASSES;
+	rate = (uint64_t)((double)bytes * 1e5 / elapsed);
+	ft_putstr(label);
+	ft_putnbr_u64(bytes, 0);
+	ft_putstr(" octets, ");
+	ft_putnbr_u64(signals, 0);
+	ft_putstr(" signaux en ");
+	ft_putnbr_u64(elapsed / 1000, 0);
+	ft_putstr(" µs, ");
+	ft_putnbr_u64(rate / 100, 0);
+	ft_putchar('.');
+	ft_putchar('0' + rate / 10 % 10);
+	ft_putchar('0' + rate % 10);
+	ft_putstr(" Mo/s, ");
+	ft_putnbr_u64(elapsed / signals, 0);
+	ft_putstr(" ns par signal\n");
+}
+
+/**
+ * @brief Lit la taille et le mode demandés sur la ligne de commande
+ * @param argc Nombre d'arguments
+ * @param argv Tableau des arguments
+ * @return MT_BIT, MT_WORD (-r) ou MT_BLOCK (-c), -1 si les arguments
+ *         sont invalides
+ */
+static int	ft_codec_mode(int argc, char **argv)
+{
+	if (argc < 2 || argc > 3 || ft_atoi(argv[1]) <= 0)
+		return (-1);
+	if (argc == 2)
+		return (MT_BIT);
+	if (argv[2][0] == '-' && argv[2][1] == 'r' && !argv[2][2])
+		return (MT_WORD);
+	if (argv[2][0] == '-' && argv[2][1] == 'c' && !argv[2][2])
+		return (MT_BLOCK);
+	return (-1);
+}
+
+/**
+ * @brief Point d'entrée de mt-codec, le banc du codage seul
+ * @param argc Nombre d'arguments
+ * @param argv Taille du message, puis le mode
+ * @return 0 si tous les messages sont décodés intacts, 1 sinon
+ *
+ * Formats acceptés :
+ * - ./mt-codec [octets]      : bit par bit (SIGUSR1/SIGUSR2)
+ * - ./mt-codec [octets] -r   : mots de 3 octets (SIGRTMIN)
+ * - ./mt-codec [octets] -c   : blocs de 64 octets et CRC32C
+ *
+ * Deux mesures sur CODEC_PASSES passes : le codeur seul, puis le
+ * protocole entier par la boucle locale (MT_LOOPBACK), codeur,
+ * décodeur du serveur et acquittements compris, sans noyau. L'écart
+ * avec ./client mesure ce que coûtent les signaux eux-mêmes.
+ */
+int	main(int argc, char **argv)
+{
+	uint64_t	signals;
+	long		elapsed;
+	char		*buf;
+	size_t		i;
+	int			mode;
+
+	mode = ft_codec_mode(argc, argv);
+	if (mode == -1)
+	{
+		write(2, "Usage: ./mt-codec [bytes] [-r | -c]\n", 36);
+		return (1);
+	}
+	ft_codec()->len = ft_atoi(argv[1]);
+	buf = malloc(ft_codec()->len);
+	if (!buf)
+		return (1);
+	i = -1;
+	while (++i < ft_codec()->len)
+		buf[i] = 'a' + i % 26;
+	ft_codec()->src = buf;
+	ft_out_init();
+	elapsed = ft_codec_encode(mode, &signals);
+	ft_codec_print("Codage        : ", signals, elapsed);
+	elapsed = ft_codec_loop(mode);
+	ft_codec_print("Boucle locale : ", signals, elapsed);
+	ft_out_flush();
+	free(buf);
+	if (ft_codec()->good == CODEC_PASSES)
+		return (0);
+	write(2, "Error: loopback message lost or corrupted\n", 42);
+	return (1);
+}
@@ -0,0 +1,136 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   mt_server.c                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fdi-tria <fdi-tria@student.42lausanne.c    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 11:33:09 by fdi-tria          #+#    #+#             */
+/*   Updated: 2026/10/16 14:36:20 by fdi-tria         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/* Définition des standards POSIX pour sigaction() et les signaux temps réel */
+#define _POSIX_C_SOURCE 199309L
+#define _XOPEN_SOURCE 700
+#define _DEFAULT_SOURCE
+#include "minitalk.h"
+
+/**
+ * @brief Accès au message remis au rappel de mt_server_run
+ * @return État unique, sans rappel au démarrage
+ * 
+ * mt-codec y installe son propre rappel : les messages décodés par la
+ * boucle locale lui sont remis sans passer par la sortie standard.
+ */
+t_msg	*ft_msg(void)
+{
+	static t_msg	msg;
+
+	return (&msg);
+}
+
+/**
+ * @brief Double la capacité du message en cours
+ * @param m État du message
+ * @return 1 si la place est disponible, 0 si l'allocation échoue
+ * 
+ * Appelée hors gestionnaire seulement : le rappel n'est installé que
+ * par mt_server_run, dont la boucle signalfd décode dans le contexte
+ * normal du programme, où malloc() est permis.
+ */
+static int	ft_msg_grow(t_msg *m)
+{
+	char	*buf;
+	size_t	cap;
+	size_t	i;
+
+	cap = MSG_INIT_CAP;
+	if (m->cap)
+		cap = m->cap * 2;
+	buf = malloc(cap);
+	if (!buf)
+		return (0);
+	i = -1;
+	while (++i < m->len)
+		buf[i] = m->buf[i];
+	free(m->buf);
+	m->buf = buf;
+	m->cap = cap;
+	return (1);
+}
+
+/**
+ * @brief Ajoute un octet reçu au message remis au rappel
+ * @param c Octet reçu, hors '\0' terminal
+ * @return 1 si l'octet est pris en charge, 0 sans rappel installé :
+ *         l'appelant l'affiche alors au fil de l'eau
+ * 
+ * Faute de mémoire, le reste du message est ignoré et le message est
+ * abandonné à sa fin ; le serveur continue de l'acquitter.
+ */
+int	ft_msg_push(unsigned char c)
+{
+	t_msg	*m;
+
+	m = ft_msg();
+	if (!m->hook)
+		return (0);
+	if (m->failed)
+		return (1);
+	if (m->len == m->cap && !ft_msg_grow(m))
+	{
+		m->failed = 1;
+		return (1);
+	}
+	m->buf[m->len++] = c;
+	return (1);
+}
+
+/**
+ * @brief Remet le message complet au rappel
+ * @param pid PID du client émetteur
+ * @return 1 si le message est pris en charge, 0 sans rappel installé
+ * 
+ * Le tampon est conservé d'un message à l'autre : un flux de messages
+ * de taille comparable n'alloue plus rien après le premier.
+ */
+int	ft_msg_end(pid_t pid)
+{
+	t_msg	*m;
+
+	m = ft_msg();
+	if (!m->hook)
+		return (0);
+	if (m->failed)
+		write(2, "Error: Message dropped, out of memory\n", 38);
+	else
+		m->hook(pid, m->buf, m->len);
+	m->len = 0;
+	m->failed = 0;
+	return (1);
+}
+
+/**
+ * @brief Exécute un serveur Minitalk dans le programme appelant
+ * @param on_message Rappel appelé une fois par message complet, ou
+ *                   NULL pour afficher les messages sur la sortie
+ *                   standard comme ./server -e
+ * @return 1 si la boucle n'a pas pu être mise en place ; ne retourne
+ *         pas en fonctionnement normal
+ * 
+ * Le serveur tourne sur la boucle signalfd + epoll (ft_loop_run) :
+ * SIGUSR1, SIGUSR2 et les signaux temps réel du protocole sont
+ * bloqués dans le programme, et le rappel s'exécute hors de tout
+ * gestionnaire de signaux. D'autres descripteurs peuvent rejoindre la
+ * boucle avec ft_loop_watch avant l'appel.
+ */
+int	mt_server_run(t_mt_on_message on_message)
+{
+	ft_msg()->hook = on_message;
+	if (!on_message)
+		ft_out_init();
+	ft_trace_init();
+	ft_crc32c_init();
+	return (ft_loop_run());
+}
@@ -0,0 +1,73 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   mt_trace.c                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fdi-tria <fdi-tria@student.42lausanne.c    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 13:46:21 by fdi-tria          #+#    #+#             */
+/*   Updated: 2026/10/16 14:18:37 by fdi-tria         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/* Définition des standards POSIX pour les signaux temps réel */
+#define _POSIX_C_SOURCE 199309L
+#define _XOPEN_SOURCE 700
+#define _DEFAULT_SOURCE
+#include "minitalk.h"
+
+/**
+ * @brief Indique si un argument est l'option attendue
+ * @param arg Argument de la ligne de commande
+ * @param opt Lettre de l'option
+ * @return 1 si arg vaut "-opt", 0 sinon
+ */
+static int	ft_is_opt(const char *arg, char opt)
+{
+	return (arg[0] == '-' && arg[1] == opt && !arg[2]);
+}
+
+/**
+ * @brief Point d'entrée de mt-trace, le lecteur du journal des signaux
+ * @param argc Nombre d'arguments
+ * @param argv Journal, puis options
+ * @return 0 en cas de succès, 1 en cas d'erreur
+ *
+ * Formats acceptés :
+ * - ./mt-trace [fichier]        : bilan par couple client/serveur,
+ *                                 écarts et aller-retour en étapes
+ * - ./mt-trace [fichier] -t     : chronologie complète, puis le bilan
+ * - ./mt-trace [fichier] -r [N] : rejoue N fois les réceptions dans
+ *                                 le décodeur du serveur et mesure
+ *                                 son débit, sans signaux
+ */
+int	main(int argc, char **argv)
+{
+	t_trace_log	log;
+	int			ret;
+
+	ret = -1;
+	if (argc == 2)
+		ret = 0;
+	else if (argc == 3 && ft_is_opt(argv[2], 't'))
+		ret = 0;
+	else if (argc == 4 && ft_is_opt(argv[2], 'r') && ft_atoi(argv[3]) > 0)
+		ret = 0;
+	if (ret == -1)
+	{
+		write(2, "Usage: ./mt-trace [file] [-t | -r passes]\n", 42);
+		return (1);
+	}
+	ft_out_init();
+	if (ft_trace_load(argv[1], &log) == -1)
+		return (1);
+	if (argc == 4)
+		ret = ft_trace_replay(&log, ft_atoi(argv[3]));
+	if (argc == 3)
+		ft_trace_timeline(&log);
+	if (argc < 4)
+		ft_trace_report(&log);
+	ft_out_flush();
+	free(log.ev);
+	return (ret);
+}
@@ -6,7 +6,7 @@
 /*   By: fdi-tria <fdi-tria@student.42lausanne.c    +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/01/25 19:21:49 by fdi-tria          #+#    #+#             */
-/*   Updated: 2025/01/26 00:42:06 by fdi-tria         ###   ########.fr       */
+/*   Updated: 2026/10/16 14:21:12 by fdi-tria         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -64,102 +64,33 @@
  */
 static volatile sig_atomic_t	g_data = 0;
 
-/**
- * @brief Gère le traitement final d'un caractère reconstruit
- * @param c Caractère complet reconstruit à partir des bits reçus
- * @param client_pid Pointeur vers le PID du client émetteur
- * @param i Pointeur vers le compteur de bits
- * 
- * Cette fonction représente la dernière étape du processus de réception,
- * intervenant une fois qu'un caractère complet a été reconstruit.
- * Elle implémente une logique sophistiquée de fin de transmission :
- * 
- * Pour un caractère normal :
- * - Affiche le caractère immédiatement
- * - Réinitialise le compteur de bits pour le prochain caractère
- * 
- * Pour le caractère nul (fin de message) :
- * - Marque la fin visuelle du message avec un saut de ligne
- * - Envoie un signal SIGUSR2 au client pour confirmer la réception complète
- * - Réinitialise le PID client pour accepter une nouvelle connexion
- * 
- * La fonction est conçue pour être :
- * - Réentrante : Sûre en cas d'appels concurrents
- * - Efficace : Opérations minimales
- * - Robuste : Gestion appropriée des états
- */
-static void	ft_handle_char(unsigned char c, pid_t *client_pid, int *i)
-{
-	*i = 0;
-	if (!c)
-	{
-		ft_putchar('\n');
-		kill(*client_pid, SIGUSR2);
-		*client_pid = 0;
-		return ;
-	}
-	ft_putchar(c);
-}
-
 /**
  * @brief Gestionnaire principal des signaux du serveur
- * @param sig Signal reçu (SIGUSR1 ou SIGUSR2)
+ * @param sig Signal reçu (SIGUSR1, SIGUSR2 ou SIGRTMIN + 0 à 2)
  * @param info Structure contenant les informations détaillées du signal
  * @param context Contexte d'exécution (non utilisé)
  * 
- * Cette fonction est le cœur du serveur Minitalk, implémentant un protocole
- * sophistiqué de reconstruction de caractères à partir de signaux binaires.
- * 
- * Architecture de la reconstruction :
- * 
- * 1. Gestion de l'état :
- *    - Variables statiques pour préserver l'état entre les appels
- *    - Détection automatique des nouveaux clients
- *    - Maintien du contexte de reconstruction
- * 
- * 2. Protocole de reconstruction :
- *    - Décalage à gauche du buffer (c << 1)
- *    - Ajout du nouveau bit si SIGUSR2 (c | 1)
- *    - Comptage précis des bits reçus
- *    - Traitement après 8 bits complets
- * 
- * 3. Mécanisme de confirmation :
- *    - Envoi d'acquittement pour chaque bit (SIGUSR1)
- *    - Activation du flag global pour la boucle principale
+ * Transmet le signal à ft_server_signal avec l'émetteur et la valeur
+ * lus dans info, puis active le flag global pour la boucle principale.
+ * Avec MT_TRACE, le signal est d'abord inscrit au journal, horodaté à
+ * son arrivée dans le gestionnaire.
  * 
  * Aspects de sécurité :
- * - Protection contre les signaux non sollicités
- * - Maintien de la cohérence des données
- * - Gestion robuste des états
- * 
- * La fonction utilise des variables statiques pour maintenir l'état :
- * - i : Position du bit en cours (0-7)
- * - c : Caractère en cours de reconstruction
- * - client_pid : Identifiant du client actif
+ * - Tous les signaux sont masqués pendant le handler
+ * - L'état de reconstruction n'est jamais modifié de façon concurrente
  */
 static void	ft_receive(int sig, siginfo_t *info, void *context)
 {
-	static int				i = 0;
-	static unsigned char	c = 0;
-	static pid_t			client_pid = 0;
-
 	(void)context;
-	if (!client_pid)
-		client_pid = info->si_pid;
-	c = c << 1;
-	if (sig == SIGUSR2)
-		c = c | 1;
-	if (++i == 8)
-		ft_handle_char(c, &client_pid, &i);
-	if (client_pid)
-	{
-		kill(client_pid, SIGUSR1);
-		g_data = 1;
-	}
+	ft_trace_rec(TRACE_RECV | sig, info->si_pid, info->si_value.sival_int);
+	ft_server_signal(sig, info->si_pid, info->si_value.sival_int);
+	g_data = 1;
 }
 
 /**
  * @brief Point d'entrée principal du serveur Minitalk
+ * @param argc Nombre d'arguments
+ * @param argv Tableau des arguments ("-e" active la boucle signalfd)
  * 
  * Cette fonction met en place et exécute le serveur de communication
  * basé sur les signaux UNIX. Elle implémente une architecture 
@@ -171,18 +102,27 @@ static void	ft_receive(int sig, siginfo_t *info, void *context)
  *    - Récupération et affichage du PID
  *    - Le PID est crucial car les clients en ont besoin pour
  *      établir la communication
+ *    - Tables du CRC32C construites avant tout signal (-c)
+ *    - Journal des signaux ouvert si MT_TRACE le désigne
  * 
  * 2. Configuration des signaux :
  *    - Initialisation de la structure sigaction
  *    - Configuration du masque de signaux
  *    - Activation du mode SA_SIGINFO pour des informations détaillées
- *    - Installation des handlers pour SIGUSR1 et SIGUSR2
+ *    - Installation des handlers pour SIGUSR1, SIGUSR2, SIGRTMIN, puis
+ *      les mots et le CRC des blocs contrôlés (RT_BLOCK, RT_BLOCK_CRC)
+ *    - Tous les signaux sont masqués pendant le handler, qui n'est
+ *      pas réentrant
  * 
  * 3. Boucle principale :
  *    - Attente économe avec pause()
  *    - Surveillance du flag global
  *    - Réinitialisation du flag après traitement
  * 
+ * Avec l'option -e, les étapes 2 et 3 sont remplacées par
+ * mt_server_run(NULL), le serveur de libminitalk : les signaux sont
+ * bloqués et lus par lots sur un signalfd via epoll.
+ * 
  * Gestion d'erreur :
  * - Vérification de l'installation des handlers
  * - Message d'erreur explicite en cas d'échec
@@ -193,17 +133,26 @@ static void	ft_receive(int sig, siginfo_t *info, void *context)
  * - Le flag g_data coordonne le traitement des données
  * - Architecture non bloquante et réactive
  */
-int	main(void)
+int	main(int argc, char **argv)
 {
 	struct sigaction	sa;
 
+	ft_out_init();
+	ft_trace_init();
 	ft_putnbr(getpid());
-	write(1, "\n", 1);
-	sigemptyset(&sa.sa_mask);
+	ft_putchar('\n');
+	ft_out_flush();
+	ft_crc32c_init();
+	if (argc == 2 && argv[1][0] == '-' && argv[1][1] == 'e' && !argv[1][2])
+		return (mt_server_run(NULL));
+	sigfillset(&sa.sa_mask);
 	sa.sa_sigaction = ft_receive;
 	sa.sa_flags = SA_SIGINFO;
 	if (sigaction(SIGUSR1, &sa, NULL) == -1
-		|| sigaction(SIGUSR2, &sa, NULL) == -1)
+		|| sigaction(SIGUSR2, &sa, NULL) == -1
+		|| sigaction(SIGRTMIN, &sa, NULL) == -1
+		|| sigaction(SIGRTMIN + RT_BLOCK, &sa, NULL) == -1
+		|| sigaction(SIGRTMIN + RT_BLOCK_CRC, &sa, NULL) == -1)
 	{
 		write(2, "Error: sigaction failed\n", 23);
 		return (1);
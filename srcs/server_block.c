@@ -0,0 +1,102 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   server_block.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fdi-tria <fdi-tria@student.42lausanne.c    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 07:38:27 by fdi-tria          #+#    #+#             */
+/*   Updated: 2026/10/16 13:04:26 by fdi-tria         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @brief Active les signaux temps réel (SIGRTMIN)
+ * 
+ * Mêmes définitions que server.c : SIGRTMIN n'est exposé par
+ * <signal.h> qu'à partir de POSIX.1b (199309L).
+ */
+#define _POSIX_C_SOURCE 199309L
+#define _XOPEN_SOURCE 700
+#define _DEFAULT_SOURCE
+#include "minitalk.h"
+
+/**
+ * @brief Vérifie le bloc reçu contre le CRC32C annoncé
+ * @param rx    État de réception, mots du bloc dans block
+ * @param crc   CRC32C calculé par le client, mêlé au numéro du bloc
+ * @param bytes Reçoit les BLOCK_BYTES octets du bloc
+ * @return 1 pour le bloc attendu, -1 pour une retransmission du bloc
+ *         précédent, 0 si le bloc est incomplet ou corrompu
+ * 
+ * Les octets sont rangés comme le client les a empaquetés, premier
+ * octet dans les bits de poids fort de chaque mot. Un mot perdu ou en
+ * trop fausse le compte : le bloc est rejeté avant même le calcul.
+ */
+static int	ft_block_check(t_rx *rx, uint32_t crc, unsigned char *bytes)
+{
+	uint32_t	sum;
+	int			k;
+
+	if (rx->nwords != BLOCK_WORDS)
+		return (0);
+	k = -1;
+	while (++k < BLOCK_BYTES)
+		bytes[k] = rx->block[k / 4] >> (24 - 8 * (k % 4));
+	sum = ft_crc32c(bytes, BLOCK_BYTES);
+	if ((sum ^ (uint32_t)rx->seq) == crc)
+		return (1);
+	if ((sum ^ (uint32_t)(rx->seq - 1)) == crc)
+		return (-1);
+	return (0);
+}
+
+/**
+ * @brief Traite un mot ou le CRC d'un bloc contrôlé (-c)
+ * @param sig   SIGRTMIN + RT_BLOCK (mot) ou + RT_BLOCK_CRC (CRC)
+ * @param value Mot du bloc, ou son CRC32C mêlé au numéro du bloc
+ * @param rx    État de réception du client en cours
+ * 
+ * Les mots s'accumulent sans acquittement. À l'arrivée du CRC :
+ * - bloc intact : ses octets suivent le chemin habituel jusqu'au '\0',
+ *   puis un seul RT_ACK acquitte le bloc
+ * - bloc déjà livré (son acquittement s'est perdu) : réacquitté sans
+ *   être livré une seconde fois
+ * - bloc incomplet ou corrompu : rejet immédiat (RT_ACK portant ~seq),
+ *   le client renvoie le bloc sans attendre son délai
+ * 
+ * Le numéro ne dépend pas du signal : les mots d'un bloc renvoyé
+ * restent dans l'ordre d'envoi, et un reste de retransmission mêlé au
+ * bloc suivant ne fait qu'échouer au contrôle. Le CRC32C est calculé
+ * ici, dans le gestionnaire : les tables sont prêtes depuis
+ * ft_crc32c_init et le calcul n'alloue rien.
+ */
+void	ft_receive_block(int sig, int value, t_rx *rx)
+{
+	unsigned char	bytes[BLOCK_BYTES];
+	int				ok;
+	int				k;
+
+	if (sig == SIGRTMIN + RT_BLOCK)
+	{
+		if (rx->nwords < BLOCK_WORDS)
+			rx->block[rx->nwords] = value;
+		if (rx->nwords <= BLOCK_WORDS)
+			rx->nwords++;
+		return ;
+	}
+	ok = ft_block_check(rx, value, bytes);
+	rx->nwords = 0;
+	if (ok == -1)
+		ft_rx_ack(rx->client_pid, RT_ACK, rx->seq - 1);
+	if (!ok)
+		ft_rx_ack(rx->client_pid, RT_ACK, ~rx->seq);
+	if (ok != 1)
+		return ;
+	rx->seq++;
+	k = 0;
+	while (k < BLOCK_BYTES && rx->client_pid)
+		ft_rx_char(bytes[k++], rx);
+	if (rx->client_pid)
+		ft_rx_ack(rx->client_pid, RT_ACK, rx->seq - 1);
+}
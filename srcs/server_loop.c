@@ -0,0 +1,168 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   server_loop.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fdi-tria <fdi-tria@student.42lausanne.c    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 04:59:32 by fdi-tria          #+#    #+#             */
+/*   Updated: 2026/10/16 14:21:12 by fdi-tria         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @brief Active signalfd(), epoll et les signaux temps réel
+ * 
+ * Mêmes définitions que server.c ; signalfd et epoll sont propres à
+ * Linux et déclarés par leurs en-têtes respectifs.
+ */
+#define _POSIX_C_SOURCE 199309L
+#define _XOPEN_SOURCE 700
+#define _DEFAULT_SOURCE
+#include "minitalk.h"
+#include <sys/epoll.h>
+#include <sys/signalfd.h>
+
+/**
+ * @brief Accès à l'état unique de la boucle d'événements
+ * @return La boucle, dont l'instance epoll est créée au premier appel
+ * 
+ * La création paresseuse permet d'enregistrer des descripteurs avant
+ * ft_loop_run comme depuis un rappel en cours d'exécution.
+ */
+static t_loop	*ft_loop(void)
+{
+	static t_loop	loop;
+
+	if (!loop.epfd)
+		loop.epfd = epoll_create1(EPOLL_CLOEXEC);
+	return (&loop);
+}
+
+/**
+ * @brief Ajoute un descripteur à la boucle d'événements
+ * @param fd  Descripteur à surveiller en lecture
+ * @param cb  Fonction appelée, hors gestionnaire, quand fd est prêt
+ * @param arg Contexte transmis à cb
+ * @return 0 en cas de succès, -1 si fd est invalide ou la table pleine
+ * 
+ * Point d'extension de la boucle : le signalfd y est enregistré comme
+ * n'importe quel autre descripteur, un timerfd ou un pidfd s'ajoutent
+ * de la même manière. L'index de l'emplacement voyage dans data.u32.
+ */
+int	ft_loop_watch(int fd, t_watch_cb cb, void *arg)
+{
+	t_loop				*loop;
+	struct epoll_event	ev;
+
+	loop = ft_loop();
+	if (fd < 0 || loop->epfd < 0 || loop->count == LOOP_MAX_WATCH)
+		return (-1);
+	ev.events = EPOLLIN;
+	ev.data.u32 = loop->count;
+	if (epoll_ctl(loop->epfd, EPOLL_CTL_ADD, fd, &ev) == -1)
+		return (-1);
+	loop->watch[loop->count].fd = fd;
+	loop->watch[loop->count].cb = cb;
+	loop->watch[loop->count].arg = arg;
+	loop->count++;
+	return (0);
+}
+
+/**
+ * @brief Consomme par lots les signaux en attente sur le signalfd
+ * @param fd  Descripteur signalfd non bloquant
+ * @param arg Non utilisé
+ * 
+ * Un read() rend jusqu'à LOOP_SIG_BATCH enregistrements
+ * signalfd_siginfo : un seul réveil d'epoll suffit pour une rafale de
+ * signaux temps réel mis en file. Chaque enregistrement est décodé par
+ * ft_server_signal dans le contexte normal du programme, où write() et
+ * kill() ne sont plus limités aux fonctions async-signal-safe. Le
+ * journal (MT_TRACE) les horodate à la lecture : le signalfd ne
+ * rapporte pas l'instant d'arrivée.
+ */
+static void	ft_loop_signals(int fd, void *arg)
+{
+	struct signalfd_siginfo	batch[LOOP_SIG_BATCH];
+	ssize_t					n;
+	ssize_t					i;
+
+	(void)arg;
+	n = read(fd, batch, sizeof(batch));
+	while (n > 0)
+	{
+		i = 0;
+		while (i < n / (ssize_t) sizeof(batch[0]))
+		{
+			ft_trace_rec(TRACE_RECV | batch[i].ssi_signo, batch[i].ssi_pid,
+				batch[i].ssi_int);
+			ft_server_signal(batch[i].ssi_signo, batch[i].ssi_pid,
+				batch[i].ssi_int);
+			i++;
+		}
+		n = read(fd, batch, sizeof(batch));
+	}
+}
+
+/**
+ * @brief Bloque les signaux du protocole et les redirige vers un signalfd
+ * @return 0 en cas de succès, -1 en cas d'échec
+ * 
+ * Les signaux bloqués ne sont plus délivrés à un gestionnaire : ils
+ * restent en attente et le signalfd devient lisible. Le blocage doit
+ * précéder la création du signalfd pour qu'aucun signal n'arrive
+ * entre les deux avec l'action par défaut (terminaison).
+ */
+static int	ft_loop_setup(void)
+{
+	sigset_t	mask;
+
+	sigemptyset(&mask);
+	sigaddset(&mask, SIGUSR1);
+	sigaddset(&mask, SIGUSR2);
+	sigaddset(&mask, SIGRTMIN);
+	sigaddset(&mask, SIGRTMIN + RT_BLOCK);
+	sigaddset(&mask, SIGRTMIN + RT_BLOCK_CRC);
+	if (sigprocmask(SIG_BLOCK, &mask, NULL) == -1)
+		return (-1);
+	return (ft_loop_watch(signalfd(-1, &mask, SFD_NONBLOCK | SFD_CLOEXEC),
+			ft_loop_signals, NULL));
+}
+
+/**
+ * @brief Exécute le serveur sur une boucle signalfd + epoll (option -e)
+ * @return 1 si la boucle n'a pas pu être mise en place
+ * 
+ * Remplace le couple gestionnaire asynchrone + pause() : epoll_wait()
+ * rend la main quand un descripteur enregistré est prêt, puis le
+ * rappel associé est exécuté. La fonction ne retourne pas en
+ * fonctionnement normal.
+ */
+int	ft_loop_run(void)
+{
+	t_loop				*loop;
+	struct epoll_event	events[LOOP_MAX_EVENTS];
+	t_watch				*w;
+	int					n;
+	int					i;
+
+	loop = ft_loop();
+	if (ft_loop_setup() == -1)
+	{
+		write(2, "Error: event loop setup failed\n", 31);
+		return (1);
+	}
+	while (1)
+	{
+		n = epoll_wait(loop->epfd, events, LOOP_MAX_EVENTS, -1);
+		i = 0;
+		while (i < n)
+		{
+			w = &loop->watch[events[i].data.u32];
+			w->cb(w->fd, w->arg);
+			i++;
+		}
+	}
+	return (0);
+}
@@ -0,0 +1,246 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   server_rx.c                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fdi-tria <fdi-tria@student.42lausanne.c    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 06:52:33 by fdi-tria          #+#    #+#             */
+/*   Updated: 2026/10/16 15:20:00 by fdi-tria         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @brief Active les signaux temps réel (SIGRTMIN)
+ * 
+ * Mêmes définitions que server.c : SIGRTMIN et siginfo_t ne sont
+ * exposés par <signal.h> qu'à partir de POSIX.1b (199309L).
+ */
+#define _POSIX_C_SOURCE 199309L
+#define _XOPEN_SOURCE 700
+#define _DEFAULT_SOURCE
+#include "minitalk.h"
+#include <errno.h>
+
+/**
+ * @brief Acquitte une unité en rappelant son numéro de séquence
+ * @param pid PID du client
+ * @param kind RT_ACK pour une unité, RT_DONE pour la fin du message
+ * @param seq Numéro de l'unité acquittée
+ * 
+ * Le client ignore tout acquittement dont le numéro ne correspond pas
+ * à l'unité qu'il attend : un doublon tardif ne peut pas valider
+ * l'unité suivante à sa place. Les acquittements partent sur des
+ * signaux temps réel, mis en file : SIGUSR1 et SIGUSR2 de plusieurs
+ * serveurs vers un même client (mt_broadcast) seraient fusionnés par
+ * le noyau tant que le client les bloque. Pendant un rejeu (mt-trace
+ * -r), rien ne part : les PID du journal ne désignent plus les mêmes
+ * processus. Avec la boucle locale (MT_LOOPBACK), l'acquittement est
+ * mis en file pour le client du même processus.
+ */
+void	ft_rx_ack(pid_t pid, int kind, int seq)
+{
+	if (ft_trace()->replay)
+		return ;
+	ft_trace_rec(TRACE_ACK | (SIGRTMIN + kind), pid, seq);
+	ft_transport()->send_ack(pid, SIGRTMIN + kind, seq);
+}
+
+/**
+ * @brief Indique si un signal porte l'unité numéro seq
+ * @param sig   Signal reçu
+ * @param value Valeur attachée par sigqueue()
+ * @param seq   Numéro attendu
+ * @return 1 si c'est l'unité seq, 0 si c'est une retransmission
+ * 
+ * Un bit (SIGUSR1/SIGUSR2) transporte son numéro dans value. Un mot
+ * SIGRTMIN n'en garde que les 8 bits de poids faible, dans son octet de
+ * poids fort : le client attend chaque acquittement et les signaux
+ * SIGRTMIN sont délivrés dans l'ordre, un doublon ne peut donc être
+ * qu'une unité récente et 8 bits suffisent à le reconnaître. Les
+ * signaux d'un bloc ne sont identifiés que par son CRC
+ * (ft_receive_block) : ils sont tous attribués à l'unité seq.
+ */
+static int	ft_is_unit(int sig, int value, int seq)
+{
+	if (sig == SIGUSR1 || sig == SIGUSR2)
+		return (value == seq);
+	if (sig == SIGRTMIN)
+		return (((unsigned int)value >> 24) == (unsigned int)(seq & 0xFF));
+	return (1);
+}
+
+/**
+ * @brief Gère le traitement final d'un caractère reconstruit
+ * @param c  Caractère complet reconstruit à partir des bits reçus
+ * @param rx État de réception du client en cours
+ * 
+ * Pour un caractère normal :
+ * - Ajoute le caractère au tampon de sortie, ou au message remis au
+ *   rappel de mt_server_run
+ * - Réinitialise le compteur de bits pour le prochain caractère
+ * 
+ * Pour le caractère nul (fin de message) :
+ * - Marque la fin visuelle du message avec un saut de ligne et vide le
+ *   tampon de sortie, ou remet le message complet au rappel
+ * - Envoie SIGRTMIN + RT_DONE au client pour confirmer la réception complète
+ * - Libère la place pour une nouvelle connexion, en retenant le client
+ *   et sa dernière unité pour pouvoir reconfirmer si RT_DONE se perd
+ */
+void	ft_rx_char(unsigned char c, t_rx *rx)
+{
+	rx->i = 0;
+	if (!c)
+	{
+		if (!ft_msg_end(rx->client_pid))
+		{
+			ft_putchar('\n');
+			ft_out_flush();
+		}
+		ft_rx_ack(rx->client_pid, RT_DONE, rx->seq - 1);
+		rx->last_pid = rx->client_pid;
+		rx->last_seq = rx->seq - 1;
+		rx->client_pid = 0;
+		return ;
+	}
+	if (!ft_msg_push(c))
+		ft_putchar(c);
+}
+
+/**
+ * @brief Traite un mot reçu en mode temps réel
+ * @param word Valeur transportée par sigval.sival_int
+ * @param rx   État de réception du client en cours
+ * 
+ * Sous l'octet de numéro, le mot contient jusqu'à 3 caractères, le
+ * premier dans les bits 16 à 23. Chacun passe par ft_rx_char
+ * exactement comme un caractère reconstruit bit par bit. Dès que le
+ * '\0' terminal est traité, client_pid repasse à 0 et les octets de
+ * bourrage qui suivent dans le mot sont ignorés.
+ */
+static void	ft_receive_word(unsigned int word, t_rx *rx)
+{
+	int	shift;
+
+	shift = 16;
+	while (shift >= 0 && rx->client_pid)
+	{
+		ft_rx_char((word >> shift) & 0xFF, rx);
+		shift -= 8;
+	}
+}
+
+/**
+ * @brief Libère le client en cours s'il a disparu ou s'est tu
+ * @param rx État de réception, appelé quand un autre client se présente
+ * 
+ * Un client tué au milieu d'un message ne l'achève jamais : sans cette
+ * libération, tous les clients suivants seraient ignorés jusqu'au
+ * redémarrage du serveur. Le client en cours est oublié dès que
+ * kill(pid, 0) le dit disparu (ESRCH), ou quand il n'a rien envoyé
+ * depuis LINK_RTO_MAX_US * LINK_RETX_MAX, délai après lequel lui-même
+ * aurait abandonné. Pendant un rejeu (mt-trace -r), les PID du journal
+ * ne désignent plus de processus : seul le délai s'applique. Le
+ * message interrompu est abandonné : le texte déjà affiché est clos
+ * par un saut de ligne, le message destiné au rappel est vidé.
+ */
+static void	ft_rx_expire(t_rx *rx)
+{
+	t_msg	*m;
+
+	if (ft_now() - rx->last_rx < LINK_RTO_MAX_US * 1000L * LINK_RETX_MAX
+		&& (ft_trace()->replay || kill(rx->client_pid, 0) == 0
+			|| errno != ESRCH))
+		return ;
+	m = ft_msg();
+	if (!m->hook)
+	{
+		ft_putchar('\n');
+		ft_out_flush();
+	}
+	m->len = 0;
+	m->failed = 0;
+	rx->client_pid = 0;
+}
+
+/**
+ * @brief Décode un signal reçu, quelle que soit la façon dont il arrive
+ * @param sig   Signal reçu (SIGUSR1, SIGUSR2 ou SIGRTMIN + 0 à 2)
+ * @param pid   PID de l'émetteur
+ * @param value Valeur attachée par sigqueue()
+ * 
+ * Appelée par le gestionnaire ft_receive en mode classique et par la
+ * boucle signalfd (ft_loop_run) en mode -e.
+ * 
+ * 1. Un client qui vient de finir renvoie sa dernière unité : son
+ *    RT_DONE s'est perdu, il est renvoyé (une seule fois par bloc, à
+ *    l'arrivée de son CRC)
+ * 2. Un nouveau message repart d'un état propre (bit 0, unité 0) : un
+ *    message interrompu ne laisse pas d'octet à moitié reconstruit. Un
+ *    message qui commence par un bit reprend le numéro de ce bit :
+ *    mt_send numérote les messages successifs d'un même processus à
+ *    la suite, et le client précédent, s'il est l'émetteur, est
+ *    oublié pour que ses nouvelles unités ne passent pas pour des
+ *    doublons
+ * 3. Les signaux d'un autre client sont ignorés pendant un message :
+ *    sans acquittement, il retransmet plus tard et passe à son tour.
+ *    Si le client en cours a disparu ou se tait depuis trop longtemps,
+ *    ft_rx_expire le libère et l'autre client prend sa place
+ * 4. Les mots et le CRC d'un bloc (-c) sont confiés à ft_receive_block,
+ *    qui n'acquitte qu'une fois par bloc
+ * 5. Une unité déjà reçue (son acquittement s'est perdu) est
+ *    acquittée de nouveau sans être traitée une seconde fois
+ * 6. Sinon, le bit est ajouté au caractère en cours (8 bits, poids
+ *    fort d'abord) ou le mot temps réel est découpé en 3 caractères,
+ *    puis l'unité est acquittée par SIGRTMIN + RT_ACK
+ */
+void	ft_server_signal(int sig, pid_t pid, int value)
+{
+	static t_rx	rx;
+
+	if (pid == rx.last_pid && ft_is_unit(sig, value, rx.last_seq))
+	{
+		if (sig != SIGRTMIN + RT_BLOCK)
+			ft_rx_ack(pid, RT_DONE, rx.last_seq);
+		return ;
+	}
+	if (rx.client_pid && pid != rx.client_pid)
+		ft_rx_expire(&rx);
+	if (!rx.client_pid)
+	{
+		rx.client_pid = pid;
+		rx.seq = 0;
+		if (sig == SIGUSR1 || sig == SIGUSR2)
+			rx.seq = value;
+		if (pid == rx.last_pid)
+			rx.last_pid = 0;
+		rx.i = 0;
+		rx.nwords = 0;
+	}
+	if (pid != rx.client_pid)
+		return ;
+	rx.last_rx = ft_now();
+	if (sig >= SIGRTMIN + RT_BLOCK)
+	{
+		ft_receive_block(sig, value, &rx);
+		return ;
+	}
+	if (!ft_is_unit(sig, value, rx.seq))
+	{
+		ft_rx_ack(pid, RT_ACK, rx.seq - 1);
+		return ;
+	}
+	rx.seq++;
+	if (sig != SIGUSR1 && sig != SIGUSR2)
+		ft_receive_word(value, &rx);
+	else
+	{
+		rx.c = rx.c << 1;
+		if (sig == SIGUSR2)
+			rx.c = rx.c | 1;
+		if (++rx.i == 8)
+			ft_rx_char(rx.c, &rx);
+	}
+	if (rx.client_pid)
+		ft_rx_ack(pid, RT_ACK, rx.seq - 1);
+}
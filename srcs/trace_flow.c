@@ -0,0 +1,122 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   trace_flow.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fdi-tria <fdi-tria@student.42lausanne.c    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 13:46:21 by fdi-tria          #+#    #+#             */
+/*   Updated: 2026/10/16 14:18:37 by fdi-tria         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/* Définition des standards POSIX pour les signaux temps réel */
+#define _POSIX_C_SOURCE 199309L
+#define _XOPEN_SOURCE 700
+#define _DEFAULT_SOURCE
+#include "minitalk.h"
+
+/**
+ * @brief Retrouve les échanges d'un client avec un serveur, ou les crée
+ * @param flows  Table de TRACE_FLOWS couples, client 0 si libre
+ * @param client PID du client
+ * @param server PID du serveur
+ * @return Le couple, ou NULL si la table est pleine
+ *
+ * Une diffusion (mt_broadcast) ou des voies parallèles (-j) donnent un
+ * couple par serveur ou par voie : leurs étapes ne se mélangent pas.
+ */
+static t_flow	*ft_flow_get(t_flow *flows, pid_t client, pid_t server)
+{
+	int	i;
+
+	i = 0;
+	while (i < TRACE_FLOWS && flows[i].client
+		&& (flows[i].client != client || flows[i].server != server))
+		i++;
+	if (i == TRACE_FLOWS)
+		return (NULL);
+	flows[i].client = client;
+	flows[i].server = server;
+	return (&flows[i]);
+}
+
+/**
+ * @brief Ferme l'étape k d'un couple si elle est ouverte
+ * @param f   Couple client/serveur
+ * @param k   Étape : 0 aller, 1 serveur, 2 retour, 3 client
+ * @param now Instant de l'événement qui ferme l'étape
+ */
+static void	ft_stage_close(t_flow *f, int k, uint64_t now)
+{
+	t_stage		*s;
+	uint64_t	d;
+
+	if (!f->mark[k])
+		return ;
+	s = &f->stage[k];
+	d = now - f->mark[k];
+	if (!s->n || d < s->min)
+		s->min = d;
+	if (d > s->max)
+		s->max = d;
+	s->sum += d;
+	s->n++;
+	f->mark[k] = 0;
+}
+
+/**
+ * @brief Fait avancer les étapes d'un couple d'un événement
+ * @param flows Table des couples
+ * @param ev    Événement, dans l'ordre chronologique
+ *
+ * Un aller-retour se découpe en quatre étapes, chacune ouverte par un
+ * événement et fermée par le suivant : aller (envoi → réception par le
+ * serveur), serveur (réception → acquittement), retour (acquittement →
+ * réception par le client) et client (acquittement reçu → envoi
+ * suivant). Une unité de plusieurs signaux (bloc -c) compte de son
+ * premier envoi à sa première réception, et de sa dernière réception
+ * à son acquittement. Le découpage suppose une unité en vol à la
+ * fois : avec une fenêtre (-w), les durées de plusieurs unités se
+ * mêlent.
+ */
+static void	ft_flow_event(t_flow *flows, const t_trace_ev *ev)
+{
+	t_flow	*f;
+	int		kind;
+	int		k;
+
+	kind = ev->what & TRACE_KIND;
+	if (kind == TRACE_SEND || kind == TRACE_ACKED)
+		f = ft_flow_get(flows, ev->self, ev->peer);
+	else
+		f = ft_flow_get(flows, ev->peer, ev->self);
+	if (!f)
+		return ;
+	k = (kind >> 8) - 1;
+	ft_stage_close(f, (k + TRACE_STAGES - 1) % TRACE_STAGES, ev->time);
+	if (kind == TRACE_RECV && f->recvs && ev->time - f->last > f->max_gap)
+		f->max_gap = ev->time - f->last;
+	if (kind == TRACE_RECV && !f->recvs++)
+		f->first = ev->time;
+	if (kind == TRACE_RECV)
+		f->last = ev->time;
+	if (kind == TRACE_RECV || kind == TRACE_ACKED || !f->mark[k])
+		f->mark[k] = ev->time;
+}
+
+/**
+ * @brief Reconstitue les échanges de chaque couple client/serveur
+ * @param log   Journal relu par ft_trace_load
+ * @param flows Table de TRACE_FLOWS couples, nulle au départ et remplie
+ *              dans l'ordre d'apparition ; les couples au-delà sont
+ *              ignorés
+ */
+void	ft_trace_flows(const t_trace_log *log, t_flow *flows)
+{
+	size_t	i;
+
+	i = 0;
+	while (i < log->n)
+		ft_flow_event(flows, &log->ev[i++]);
+}
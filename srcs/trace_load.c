@@ -0,0 +1,164 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   trace_load.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fdi-tria <fdi-tria@student.42lausanne.c    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 13:46:21 by fdi-tria          #+#    #+#             */
+/*   Updated: 2026/10/16 14:18:37 by fdi-tria         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/* Définition des standards POSIX pour mmap() et les signaux temps réel */
+#define _POSIX_C_SOURCE 199309L
+#define _XOPEN_SOURCE 700
+#define _DEFAULT_SOURCE
+#include "minitalk.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/**
+ * @brief Vérifie qu'une projection contient un journal complet
+ * @param hdr  Début du fichier projeté
+ * @param size Taille du fichier
+ * @return 1 si l'en-tête est valide et la taille cohérente, 0 sinon
+ */
+static int	ft_trace_valid(const t_trace_hdr *hdr, size_t size)
+{
+	int	i;
+
+	if (size < sizeof(*hdr))
+		return (0);
+	i = -1;
+	while (++i < 8)
+		if (hdr->magic[i] != TRACE_MAGIC[i])
+			return (0);
+	return (hdr->version == TRACE_VERSION && hdr->cap
+		&& !(hdr->cap & (hdr->cap - 1))
+		&& size == sizeof(*hdr) + (size_t)hdr->cap * sizeof(t_trace_ev));
+}
+
+/**
+ * @brief Copie un événement publié, ou l'écarte s'il est réécrit
+ * @param src  Emplacement dans l'anneau
+ * @param rank Rang attendu dans cet emplacement
+ * @param hdr  En-tête du journal (SIGRTMIN de l'enregistreur)
+ * @param dst  Reçoit l'événement, numéro de signal ramené à SIGRTMIN local
+ * @return 1 si l'événement est complet, 0 sinon
+ *
+ * stamp est relu après la copie, comme un verrou de séquence : un
+ * journal encore ouvert par un serveur peut être lu pendant qu'il
+ * écrit, et un emplacement réécrit entre-temps est compté comme
+ * illisible plutôt que mêlé à un autre événement.
+ */
+static int	ft_trace_copy(const t_trace_ev *src, uint64_t rank,
+				const t_trace_hdr *hdr, t_trace_ev *dst)
+{
+	int	sig;
+
+	if (atomic_load_explicit(&src->stamp, memory_order_acquire) != rank + 1)
+		return (0);
+	dst->time = src->time;
+	dst->self = src->self;
+	dst->peer = src->peer;
+	dst->value = src->value;
+	dst->what = src->what;
+	atomic_thread_fence(memory_order_acquire);
+	if (atomic_load_explicit(&src->stamp, memory_order_relaxed) != rank + 1)
+		return (0);
+	sig = dst->what & TRACE_SIG;
+	if (sig >= (int)hdr->rtmin)
+		sig = sig - hdr->rtmin + SIGRTMIN;
+	dst->what = (dst->what & TRACE_KIND) | sig;
+	return (1);
+}
+
+/**
+ * @brief Trie les événements par instant croissant
+ * @param log Journal relu
+ *
+ * Par insertion : les rangs sont réservés juste après la lecture de
+ * l'horloge, les événements arrivent donc presque triés et chacun ne
+ * recule que de quelques places (un enregistreur interrompu entre les
+ * deux). Le tri est alors linéaire en pratique.
+ */
+static void	ft_trace_sort(t_trace_log *log)
+{
+	t_trace_ev	tmp;
+	size_t		i;
+	size_t		j;
+
+	i = 0;
+	while (++i < log->n)
+	{
+		tmp = log->ev[i];
+		j = i;
+		while (j && log->ev[j - 1].time > tmp.time)
+		{
+			log->ev[j] = log->ev[j - 1];
+			j--;
+		}
+		log->ev[j] = tmp;
+	}
+}
+
+/**
+ * @brief Relit un journal et en extrait les événements valides
+ * @param path Fichier écrit par les enregistreurs (MT_TRACE)
+ * @param log  Reçoit les événements, à libérer par l'appelant (log->ev)
+ * @return 0 en cas de succès, -1 si le fichier est illisible ou n'est
+ *         pas un journal
+ *
+ * Seuls les cap derniers rangs sont encore dans l'anneau ; les
+ * précédents sont comptés comme perdus.
+ */
+int	ft_trace_load(const char *path, t_trace_log *log)
+{
+	struct stat	st;
+	t_trace_hdr	*hdr;
+	uint64_t	rank;
+	uint64_t	head;
+	int			fd;
+
+	fd = open(path, O_RDONLY | O_CLOEXEC);
+	hdr = MAP_FAILED;
+	if (fd != -1 && fstat(fd, &st) == 0 && st.st_size > 0)
+		hdr = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	if (fd != -1)
+		close(fd);
+	if (hdr == MAP_FAILED || !ft_trace_valid(hdr, st.st_size))
+	{
+		if (hdr != MAP_FAILED)
+			munmap(hdr, st.st_size);
+		write(2, "Error: not a trace file\n", 24);
+		return (-1);
+	}
+	head = atomic_load_explicit(&hdr->head, memory_order_acquire);
+	log->lost = 0;
+	if (head > hdr->cap)
+		log->lost = head - hdr->cap;
+	log->ev = malloc((head - log->lost + 1) * sizeof(t_trace_ev));
+	log->n = 0;
+	log->torn = 0;
+	log->proto = hdr->proto;
+	rank = log->lost;
+	while (log->ev && rank < head)
+	{
+		if (ft_trace_copy((t_trace_ev *)(hdr + 1) + (rank & (hdr->cap - 1)),
+			rank, hdr, &log->ev[log->n]))
+			log->n++;
+		else
+			log->torn++;
+		rank++;
+	}
+	munmap(hdr, st.st_size);
+	if (!log->ev)
+	{
+		write(2, "Error: out of memory\n", 21);
+		return (-1);
+	}
+	ft_trace_sort(log);
+	return (0);
+}
@@ -0,0 +1,109 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   trace_replay.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fdi-tria <fdi-tria@student.42lausanne.c    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 13:46:21 by fdi-tria          #+#    #+#             */
+/*   Updated: 2026/10/16 14:18:37 by fdi-tria         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/* Définition des standards POSIX pour les signaux temps réel */
+#define _POSIX_C_SOURCE 199309L
+#define _XOPEN_SOURCE 700
+#define _DEFAULT_SOURCE
+#include "minitalk.h"
+
+/**
+ * @brief Choisit le serveur dont les réceptions seront rejouées
+ * @param log Journal relu par ft_trace_load
+ * @return PID du premier serveur qui a enregistré une réception, 0 si
+ *         le journal n'en contient aucune
+ *
+ * Un journal partagé par plusieurs serveurs (mt_broadcast) mêlerait
+ * leurs flux dans un seul décodeur : seul le premier est rejoué.
+ */
+static pid_t	ft_replay_server(const t_trace_log *log)
+{
+	size_t	i;
+
+	i = 0;
+	while (i < log->n && (log->ev[i].what & TRACE_KIND) != TRACE_RECV)
+		i++;
+	if (i == log->n)
+		return (0);
+	return (log->ev[i].self);
+}
+
+/**
+ * @brief Affiche le bilan d'un rejeu
+ * @param fed     Signaux rendus au décodeur, toutes passes comprises
+ * @param elapsed Durée totale, en nanosecondes
+ */
+static void	ft_replay_print(uint64_t fed, long elapsed)
+{
+	if (elapsed < 1)
+		elapsed = 1;
+	ft_putstr("Rejeu : ");
+	ft_putnbr_u64(fed, 0);
+	ft_putstr(" signaux en ");
+	ft_putnbr_u64(elapsed / 1000, 0);
+	ft_putstr(" µs, ");
+	ft_putnbr_u64(elapsed / fed, 0);
+	ft_putstr(" ns par signal, ");
+	ft_putnbr_u64((uint64_t)((double)fed * 1e9 / elapsed), 0);
+	ft_putstr(" signaux/s\n");
+}
+
+/**
+ * @brief Rejoue les réceptions d'un journal dans le décodeur du serveur
+ * @param log    Journal relu par ft_trace_load
+ * @param passes Nombre de passes sur le journal
+ * @return 0 en cas de succès, 1 si le journal ne peut pas être rejoué
+ *
+ * Chaque réception est rendue à ft_server_signal dans l'ordre
+ * enregistré, sans noyau ni gestionnaire : la mesure ne couvre que le
+ * décodage et le tampon de sortie, où les messages sont réaffichés.
+ * ft_trace()->replay coupe l'envoi des acquittements. Le rejeu est
+ * déterministe : mêmes signaux, même ordre, mêmes messages. Une passe
+ * reprend le décodeur dans l'état où la précédente l'a laissé, d'où
+ * l'intérêt d'un journal qui couvre des messages entiers. Seul un
+ * journal du protocole obligatoire peut être rejoué.
+ */
+int	ft_trace_replay(const t_trace_log *log, int passes)
+{
+	const t_trace_ev	*ev;
+	pid_t				server;
+	uint64_t			fed;
+	long				start;
+	size_t				i;
+
+	server = ft_replay_server(log);
+	if (log->proto != TRACE_MANDATORY || !server)
+	{
+		write(2, "Error: nothing to replay\n", 25);
+		return (1);
+	}
+	ft_trace()->replay = 1;
+	ft_crc32c_init();
+	fed = 0;
+	start = ft_now();
+	while (passes-- > 0)
+	{
+		i = 0;
+		while (i < log->n)
+		{
+			ev = &log->ev[i++];
+			if ((ev->what & TRACE_KIND) != TRACE_RECV || ev->self != server)
+				continue ;
+			ft_server_signal(ev->what & TRACE_SIG, ev->peer, ev->value);
+			fed++;
+		}
+	}
+	start = ft_now() - start;
+	ft_out_flush();
+	ft_replay_print(fed, start);
+	return (0);
+}
@@ -0,0 +1,133 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   trace_report.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fdi-tria <fdi-tria@student.42lausanne.c    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 13:46:21 by fdi-tria          #+#    #+#             */
+/*   Updated: 2026/10/16 14:18:37 by fdi-tria         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/* Définition des standards POSIX pour les signaux temps réel */
+#define _POSIX_C_SOURCE 199309L
+#define _XOPEN_SOURCE 700
+#define _DEFAULT_SOURCE
+#include "minitalk.h"
+
+/**
+ * @brief Ajoute une chaîne au tampon de sortie
+ * @param s Chaîne terminée par '\0'
+ */
+void	ft_putstr(const char *s)
+{
+	size_t	len;
+
+	len = 0;
+	while (s[len])
+		len++;
+	ft_out_write(s, len);
+}
+
+/**
+ * @brief Affiche un entier non signé de 64 bits, aligné à droite
+ * @param n     Valeur à afficher
+ * @param width Largeur minimale, complétée par des espaces à gauche
+ *
+ * Même principe que ft_putnbr : chiffres produits de droite à gauche
+ * puis un seul ajout au tampon. 20 chiffres suffisent pour 2^64 - 1.
+ */
+void	ft_putnbr_u64(uint64_t n, int width)
+{
+	char	digits[32];
+	int		i;
+
+	i = 32;
+	while (i == 32 || n)
+	{
+		digits[--i] = '0' + n % 10;
+		n /= 10;
+	}
+	while (32 - i < width && i > 0)
+		digits[--i] = ' ';
+	ft_out_write(digits + i, 32 - i);
+}
+
+/**
+ * @brief Affiche le nom d'un signal du journal
+ * @param sig Numéro ramené au SIGRTMIN local par ft_trace_load
+ *
+ * Les signaux temps réel sont nommés par leur décalage depuis
+ * SIGRTMIN, comme RT_* dans minitalk.h et bonus.h : leur rôle dépend
+ * du protocole de l'enregistreur.
+ */
+static void	ft_put_sig(int sig)
+{
+	if (sig == SIGUSR1)
+		ft_putstr("SIGUSR1     ");
+	else if (sig == SIGUSR2)
+		ft_putstr("SIGUSR2     ");
+	else
+	{
+		ft_putstr("SIGRTMIN+");
+		ft_putnbr_u64(sig - SIGRTMIN, 0);
+		ft_putstr("  ");
+		if (sig - SIGRTMIN < 10)
+			ft_putstr(" ");
+	}
+}
+
+/**
+ * @brief Affiche un événement sur une ligne de la chronologie
+ * @param ev Événement
+ * @param t0 Instant du premier événement du journal
+ *
+ * Format : instant relatif en ns, processus qui enregistre, sens
+ * (-> émis, <- reçu), autre processus, nature, signal et valeur.
+ */
+static void	ft_put_event(const t_trace_ev *ev, uint64_t t0)
+{
+	int	kind;
+
+	kind = ev->what & TRACE_KIND;
+	ft_putnbr_u64(ev->time - t0, 12);
+	ft_putstr(" ns  ");
+	ft_putnbr_u64(ev->self, 7);
+	if (kind == TRACE_SEND || kind == TRACE_ACK)
+		ft_putstr(" -> ");
+	else
+		ft_putstr(" <- ");
+	ft_putnbr_u64(ev->peer, 7);
+	if (kind == TRACE_SEND)
+		ft_putstr("  envoi         ");
+	else if (kind == TRACE_RECV)
+		ft_putstr("  réception     ");
+	else if (kind == TRACE_ACK)
+		ft_putstr("  acquittement  ");
+	else
+		ft_putstr("  acquitté      ");
+	ft_put_sig(ev->what & TRACE_SIG);
+	ft_putnbr(ev->value);
+	ft_putchar('\n');
+}
+
+/**
+ * @brief Affiche la chronologie complète du journal (option -t)
+ * @param log Journal relu par ft_trace_load
+ *
+ * Les événements de tous les processus sont entrelacés par instant :
+ * CLOCK_MONOTONIC est commune à tout le système, les horodatages du
+ * client et du serveur sont donc directement comparables.
+ */
+void	ft_trace_timeline(const t_trace_log *log)
+{
+	size_t	i;
+
+	i = 0;
+	while (i < log->n)
+	{
+		ft_put_event(&log->ev[i], log->ev[0].time);
+		i++;
+	}
+}
@@ -0,0 +1,96 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   trace_stats.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fdi-tria <fdi-tria@student.42lausanne.c    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 13:46:21 by fdi-tria          #+#    #+#             */
+/*   Updated: 2026/10/16 14:18:37 by fdi-tria         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/* Définition des standards POSIX pour les signaux temps réel */
+#define _POSIX_C_SOURCE 199309L
+#define _XOPEN_SOURCE 700
+#define _DEFAULT_SOURCE
+#include "minitalk.h"
+
+/**
+ * @brief Affiche une étape de l'aller-retour : moyenne, bornes, mesures
+ * @param label Nom de l'étape et événements qui la délimitent
+ * @param s     Durées mesurées, en nanosecondes
+ */
+static void	ft_stage_print(const char *label, const t_stage *s)
+{
+	if (!s->n)
+		return ;
+	ft_putstr(label);
+	ft_putstr(" : moy ");
+	ft_putnbr_u64(s->sum / s->n, 0);
+	ft_putstr(", min ");
+	ft_putnbr_u64(s->min, 0);
+	ft_putstr(", max ");
+	ft_putnbr_u64(s->max, 0);
+	ft_putstr(" ns sur ");
+	ft_putnbr_u64(s->n, 0);
+	ft_putchar('\n');
+}
+
+/**
+ * @brief Affiche le bilan d'un couple client/serveur
+ * @param f Échanges reconstitués par ft_trace_flows
+ *
+ * Les écarts entre réceptions désignent les ralentissements vus du
+ * serveur ; l'aller-retour découpé en étapes dit où le temps passe :
+ * dans le noyau (aller, retour) ou dans l'un des deux programmes.
+ */
+static void	ft_flow_print(const t_flow *f)
+{
+	ft_putstr("\nClient ");
+	ft_putnbr(f->client);
+	ft_putstr(" -> serveur ");
+	ft_putnbr(f->server);
+	ft_putstr("\n  Signaux reçus : ");
+	ft_putnbr_u64(f->recvs, 0);
+	ft_putstr(", durée : ");
+	ft_putnbr_u64((f->last - f->first) / 1000, 0);
+	ft_putstr(" µs\n");
+	if (f->recvs > 1)
+	{
+		ft_putstr("  Écart entre réceptions : moy ");
+		ft_putnbr_u64((f->last - f->first) / (f->recvs - 1), 0);
+		ft_putstr(", max ");
+		ft_putnbr_u64(f->max_gap, 0);
+		ft_putstr(" ns\n");
+	}
+	ft_stage_print("  Aller (envoi -> réception)", &f->stage[0]);
+	ft_stage_print("  Serveur (réception -> acquittement)", &f->stage[1]);
+	ft_stage_print("  Retour (acquittement -> acquitté)", &f->stage[2]);
+	ft_stage_print("  Client (acquitté -> envoi suivant)", &f->stage[3]);
+}
+
+/**
+ * @brief Affiche le bilan du journal, couple client/serveur par couple
+ * @param log Journal relu par ft_trace_load
+ *
+ * Un journal tenu d'un seul côté (MT_TRACE donné au serveur seul, par
+ * exemple) n'a que les écarts entre réceptions, sans aller-retour.
+ */
+void	ft_trace_report(const t_trace_log *log)
+{
+	static t_flow	flows[TRACE_FLOWS];
+	int				i;
+
+	ft_putstr("Journal : ");
+	ft_putnbr_u64(log->n, 0);
+	ft_putstr(" événements, ");
+	ft_putnbr_u64(log->lost, 0);
+	ft_putstr(" écrasés, ");
+	ft_putnbr_u64(log->torn, 0);
+	ft_putstr(" illisibles\n");
+	ft_trace_flows(log, flows);
+	i = 0;
+	while (i < TRACE_FLOWS && flows[i].client)
+		ft_flow_print(&flows[i++]);
+}
@@ -0,0 +1,102 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   transport.c                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fdi-tria <fdi-tria@student.42lausanne.c    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 14:24:05 by fdi-tria          #+#    #+#             */
+/*   Updated: 2026/10/16 14:24:05 by fdi-tria         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @brief Active sigqueue() et sigtimedwait()
+ *
+ * Mêmes définitions que client_link.c : ces fonctions ne sont exposées
+ * qu'à partir de POSIX.1b (199309L).
+ */
+#define _POSIX_C_SOURCE 199309L
+#define _XOPEN_SOURCE 700
+#define _DEFAULT_SOURCE
+#include "minitalk.h"
+
+/**
+ * @brief Émet un signal du protocole par le noyau
+ * @param pid   Destinataire
+ * @param sig   SIGUSR1, SIGUSR2 ou signal temps réel
+ * @param value Valeur attachée (numéro, mot, CRC)
+ * @return 0 en cas de succès, -1 si le signal ne peut pas partir
+ *
+ * Sert aux unités du client comme aux acquittements du serveur : le
+ * signal choisi par le mode (bit, mot, bloc) suffit au noyau.
+ */
+static int	ft_signal_send(pid_t pid, int sig, int value)
+{
+	union sigval	v;
+
+	v.sival_int = value;
+	return (sigqueue(pid, sig, v));
+}
+
+/**
+ * @brief Attend un acquittement du noyau
+ * @param set  Signaux d'acquittement, bloqués par ft_link
+ * @param info Reçoit l'émetteur et la valeur
+ * @param ts   Délai maximal
+ * @return Le signal reçu, ou -1 (EAGAIN à l'échéance, EINTR)
+ */
+static int	ft_signal_wait(const sigset_t *set, siginfo_t *info,
+		const struct timespec *ts)
+{
+	return (sigtimedwait(set, info, ts));
+}
+
+/**
+ * @brief Installe les signaux du noyau (MT_SIGNAL) comme transport
+ * @param t Transport à remplir
+ */
+static void	ft_signal(t_transport *t)
+{
+	t->name = "signal";
+	t->send_symbol = ft_signal_send;
+	t->wait_ack = ft_signal_wait;
+	t->send_ack = ft_signal_send;
+}
+
+/**
+ * @brief Accès au transport en cours
+ * @return Le transport, par signaux du noyau tant que
+ *         ft_transport_use n'en a pas choisi un autre
+ *
+ * Le serveur ne le change jamais ; un client le choisit à chaque
+ * mt_send. Dans le même processus, les acquittements du décodeur
+ * partent donc par le transport du client qui l'alimente.
+ */
+t_transport	*ft_transport(void)
+{
+	static t_transport	t;
+
+	if (!t.send_symbol)
+		ft_signal(&t);
+	return (&t);
+}
+
+/**
+ * @brief Choisit le transport des envois suivants
+ * @param id MT_SIGNAL ou MT_LOOPBACK
+ * @return 0 en cas de succès, -1 si id est inconnu
+ */
+int	ft_transport_use(int id)
+{
+	t_transport	*t;
+
+	t = ft_transport();
+	if (id == MT_LOOPBACK)
+		ft_loopback(t);
+	else if (id == MT_SIGNAL)
+		ft_signal(t);
+	else
+		return (-1);
+	return (0);
+}
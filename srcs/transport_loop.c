@@ -0,0 +1,133 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   transport_loop.c                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fdi-tria <fdi-tria@student.42lausanne.c    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 14:24:05 by fdi-tria          #+#    #+#             */
+/*   Updated: 2026/10/16 14:24:05 by fdi-tria         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @brief Active les signaux temps réel et errno
+ *
+ * Mêmes définitions que client_link.c : siginfo_t et SIGRTMIN ne sont
+ * exposés qu'à partir de POSIX.1b (199309L).
+ */
+#define _POSIX_C_SOURCE 199309L
+#define _XOPEN_SOURCE 700
+#define _DEFAULT_SOURCE
+#include "minitalk.h"
+#include <errno.h>
+
+/**
+ * @brief Accès à l'état unique de la boucle locale
+ * @return File des acquittements et identités du client et du serveur
+ */
+static t_loopback	*ft_lo(void)
+{
+	static t_loopback	lo;
+
+	return (&lo);
+}
+
+/**
+ * @brief Remet une unité au décodeur du serveur, sans noyau
+ * @param pid   Serveur désigné par le client, retenu pour ses
+ *              acquittements
+ * @param sig   Signal qu'aurait émis le client
+ * @param value Valeur qu'il aurait attachée
+ * @return 0, une remise ne peut pas échouer
+ *
+ * ft_server_signal s'exécute aussitôt, dans l'appel : son
+ * acquittement est en file avant même que le client ne l'attende.
+ */
+static int	ft_lo_send(pid_t pid, int sig, int value)
+{
+	t_loopback	*lo;
+
+	lo = ft_lo();
+	lo->server = pid;
+	ft_server_signal(sig, lo->self, value);
+	return (0);
+}
+
+/**
+ * @brief Met un acquittement du décodeur en file pour le client
+ * @param pid   Client acquitté, toujours le processus lui-même
+ * @param sig   SIGRTMIN + RT_ACK ou SIGRTMIN + RT_DONE
+ * @param value Numéro acquitté
+ * @return 0 en cas de succès, -1 (EAGAIN) si la file est pleine
+ */
+static int	ft_lo_ack(pid_t pid, int sig, int value)
+{
+	t_loopback	*lo;
+
+	(void)pid;
+	lo = ft_lo();
+	if (lo->tail - lo->head == LOOPBACK_ACKS)
+	{
+		errno = EAGAIN;
+		return (-1);
+	}
+	lo->sig[lo->tail % LOOPBACK_ACKS] = sig;
+	lo->value[lo->tail % LOOPBACK_ACKS] = value;
+	lo->tail++;
+	return (0);
+}
+
+/**
+ * @brief Retire le plus ancien acquittement en file
+ * @param set  Signaux attendus ; les autres sont écartés
+ * @param info Reçoit le signal, le serveur désigné et la valeur
+ * @param ts   Non utilisé : rien ne peut arriver pendant l'attente
+ * @return Le signal, ou -1 (EAGAIN) si la file est vide
+ *
+ * Une file vide équivaut à une échéance écoulée : le client renvoie
+ * l'unité, comme après un acquittement perdu.
+ */
+static int	ft_lo_wait(const sigset_t *set, siginfo_t *info,
+		const struct timespec *ts)
+{
+	t_loopback	*lo;
+	int			sig;
+
+	(void)ts;
+	lo = ft_lo();
+	while (lo->head != lo->tail)
+	{
+		sig = lo->sig[lo->head % LOOPBACK_ACKS];
+		info->si_signo = sig;
+		info->si_pid = lo->server;
+		info->si_value.sival_int = lo->value[lo->head % LOOPBACK_ACKS];
+		lo->head++;
+		if (sigismember(set, sig) == 1)
+			return (sig);
+	}
+	errno = EAGAIN;
+	return (-1);
+}
+
+/**
+ * @brief Installe la boucle locale (MT_LOOPBACK) comme transport
+ * @param t Transport à remplir
+ *
+ * Client et décodeur du serveur partagent le processus : le client se
+ * présente sous son propre PID, la file des acquittements repart vide.
+ * Seul le codage est mesuré, sans gestionnaire ni appel système.
+ */
+void	ft_loopback(t_transport *t)
+{
+	t_loopback	*lo;
+
+	lo = ft_lo();
+	lo->head = 0;
+	lo->tail = 0;
+	lo->self = getpid();
+	t->name = "loopback";
+	t->send_symbol = ft_lo_send;
+	t->wait_ack = ft_lo_wait;
+	t->send_ack = ft_lo_ack;
+}
@@ -6,11 +6,14 @@
 /*   By: fdi-tria <fdi-tria@student.42lausanne.c    +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/01/25 19:21:46 by fdi-tria          #+#    #+#             */
-/*   Updated: 2025/01/26 00:45:24 by fdi-tria         ###   ########.fr       */
+/*   Updated: 2026/10/16 07:52:41 by fdi-tria         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
+/* Définition des standards POSIX pour clock_gettime() */
+#define _POSIX_C_SOURCE 199309L
 #include "minitalk.h"
+#include <time.h>
 
 /**
  * @brief Détermine si un caractère est un espace selon la norme C
@@ -101,116 +104,69 @@ int	ft_atoi(const char *str)
  * @brief Écrit un caractère sur la sortie standard de manière sûre
  * @param c Le caractère à écrire (transmis comme unsigned char)
  * 
- * Cette fonction fondamentale utilise l'appel système write() plutôt
- * que putchar() pour plusieurs raisons importantes :
+ * Le caractère est ajouté au tampon de sortie (ft_out_write) au lieu
+ * de provoquer un appel système write() par octet :
  * 
- * 1. Contrôle direct :
- *    - Pas d'intermédiaire de buffering
- *    - Écriture immédiate garantie
- *    - Comportement prévisible
+ * 1. Performance :
+ *    - Un seul write() par bloc de OUT_BUF_SIZE octets au plus
+ *    - Vidage explicite en fin de message (ft_out_flush)
+ *    - Vidage automatique après OUT_FLUSH_MS millisecondes
  * 
  * 2. Sécurité :
  *    - Utilise unsigned char pour éviter les problèmes de signe
- *    - Écrit exactement un octet
- *    - Pas de conversion de format
+ *    - Tampon statique, utilisable depuis un gestionnaire de signaux
  * 
- * 3. Performance :
- *    - Appel système direct
- *    - Pas de surcharge liée au buffering
- * 
- * Le descripteur 1 correspond à stdout (sortie standard).
  * Cette fonction est utilisée comme base pour toutes les
  * autres fonctions d'affichage.
  */
 void	ft_putchar(unsigned char c)
 {
-	write(1, &c, 1);
-}
-
-/**
- * @brief Gère la conversion des nombres négatifs pour l'affichage
- * @param n Pointeur vers le nombre à traiter
- * @param is_negative Pointeur vers l'indicateur de négativité
- * 
- * Cette fonction utilitaire encapsule la logique complexe de
- * gestion des nombres négatifs pour ft_putnbr. Elle utilise
- * des pointeurs pour modifier les valeurs d'origine :
- * 
- * 1. Détection de la négativité :
- *    - Vérifie si le nombre est négatif
- *    - Active le drapeau correspondant
- * 
- * 2. Traitement :
- *    - Affiche le signe moins
- *    - Convertit en positif pour le traitement
- * 
- * 3. Marquage :
- *    - Enregistre l'état de négativité
- *    - Permet un traitement spécial ultérieur
- * 
- * Cette approche modulaire simplifie la gestion des cas
- * négatifs dans la fonction principale d'affichage.
- */
-static void	ft_handle_negative(long *n, int *is_negative)
-{
-	if (*n < 0)
-	{
-		ft_putchar('-');
-		*n *= -1;
-		*is_negative = 1;
-	}
+	ft_out_write((const char *)&c, 1);
 }
 
 /**
  * @brief Convertit et affiche un nombre entier avec gestion complète des cas
  * @param n Le nombre à afficher
  * 
- * Cette fonction implémente un système complet d'affichage de nombres
- * entiers avec une gestion sophistiquée des cas particuliers :
- * 
- * 1. Architecture générale :
- *    - Conversion type pour gérer INT_MIN
- *    - Approche récursive pour décomposition
- *    - Gestion séparée de la négativité
+ * Les chiffres sont produits de droite à gauche dans un tableau local,
+ * puis le nombre complet est ajouté au tampon de sortie en un seul
+ * appel, au lieu d'une récursion avec un write() par chiffre :
+ * 123 → '3' → '2' → '1' → "123"
  * 
- * 2. Cas spéciaux :
- *    - Traitement spécifique de -2147483648
- *    - Gestion du zéro
- *    - Support des nombres négatifs
- * 
- * 3. Algorithme de conversion :
- *    - Décomposition récursive décimale
- *    - Conversion caractère par caractère
- *    - Maintien de l'ordre correct
- * 
- * La récursion permet une décomposition élégante :
- * 123 → (12, '3') → (1, '2') → ('1')
- * 
- * L'utilisation de long permet de gérer INT_MIN sans
- * problème de dépassement lors de la conversion.
+ * Cas spéciaux :
+ * - Le zéro produit un chiffre (la boucle s'exécute au moins une fois)
+ * - L'utilisation de long permet de gérer INT_MIN (-2147483648) sans
+ *   problème de dépassement lors du passage en positif
+ * - 11 caractères suffisent : signe et 10 chiffres
  */
 void	ft_putnbr(int n)
 {
-	char	c;
-	int		is_negative;
+	char	digits[11];
 	long	nb;
+	int		i;
 
-	is_negative = 0;
 	nb = n;
-	if (nb == -2147483648)
-	{
-		write(1, "-2147483648", 11);
-		return ;
-	}
-	ft_handle_negative(&nb, &is_negative);
-	if (nb >= 10)
-	{
-		ft_putnbr(nb / 10);
-		ft_putnbr(nb % 10);
-	}
-	else
+	if (nb < 0)
+		nb = -nb;
+	i = 11;
+	while (i == 11 || nb)
 	{
-		c = nb + '0';
-		ft_putchar(c);
+		digits[--i] = '0' + nb % 10;
+		nb /= 10;
 	}
+	if (n < 0)
+		digits[--i] = '-';
+	ft_out_write(digits + i, 11 - i);
+}
+
+/**
+ * @brief Horloge monotone en nanosecondes
+ * @return Instant courant, insensible aux changements d'heure
+ */
+long	ft_now(void)
+{
+	struct timespec	ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (ts.tv_sec * 1000000000L + ts.tv_nsec);
 }